@@ -0,0 +1,439 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Scalability of boost::concurrent_flat_map and boost::concurrent_node_map
+// against a boost::unordered_flat_map protected by a mutex, for varying
+// numbers of threads, read/write/erase mixes and key skew, with single-key
+// or bulk lookup. Reports throughput and sampled latency percentiles per
+// operation type. Run with --help for the available options.
+
+#include "harness.hpp"
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// operation streams
+
+enum op_type: unsigned char
+{
+    op_read,
+    op_write,
+    op_erase
+};
+
+struct op
+{
+    op_type type;
+    std::uint64_t key;
+};
+
+struct mix
+{
+    std::string name;
+    unsigned read, write, erase; // percentages
+};
+
+static std::vector<op> make_ops( std::vector<std::uint64_t> const& keys, std::size_t n, mix const& m, double skew, std::uint64_t seed )
+{
+    bench::zipf_generator zipf( keys.size(), skew );
+    boost::detail::splitmix64 rng( seed );
+
+    std::vector<op> res;
+    res.reserve( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        auto r = static_cast<unsigned>( rng() % 100 );
+        op_type type = r < m.read? op_read: r < m.read + m.write? op_write: op_erase;
+
+        res.push_back( { type, keys[ zipf( rng ) ] } );
+    }
+
+    return res;
+}
+
+// containers
+
+template<class Map> struct concurrent_map
+{
+    Map map;
+
+    void write( std::uint64_t k, std::uint64_t v )
+    {
+        map.insert_or_assign( k, v );
+    }
+
+    void erase( std::uint64_t k )
+    {
+        map.erase( k );
+    }
+
+    std::uint64_t read( std::uint64_t k ) const
+    {
+        std::uint64_t s = 0;
+        map.cvisit( k, [&]( typename Map::value_type const& x ){ s += x.second; } );
+        return s;
+    }
+
+    std::uint64_t read( std::uint64_t const* first, std::uint64_t const* last ) const
+    {
+        std::uint64_t s = 0;
+        map.cvisit( first, last, [&]( typename Map::value_type const& x ){ s += x.second; } );
+        return s;
+    }
+};
+
+struct locked_flat_map
+{
+    mutable std::mutex mtx;
+    boost::unordered_flat_map<std::uint64_t, std::uint64_t> map;
+
+    void write( std::uint64_t k, std::uint64_t v )
+    {
+        std::lock_guard<std::mutex> lck( mtx );
+        map.insert_or_assign( k, v );
+    }
+
+    void erase( std::uint64_t k )
+    {
+        std::lock_guard<std::mutex> lck( mtx );
+        map.erase( k );
+    }
+
+    std::uint64_t read( std::uint64_t k ) const
+    {
+        std::lock_guard<std::mutex> lck( mtx );
+
+        auto it = map.find( k );
+        return it != map.end()? it->second: 0;
+    }
+
+    // bulk lookup holds the lock for the whole batch
+    std::uint64_t read( std::uint64_t const* first, std::uint64_t const* last ) const
+    {
+        std::lock_guard<std::mutex> lck( mtx );
+
+        std::uint64_t s = 0;
+
+        for( ; first != last; ++first )
+        {
+            auto it = map.find( *first );
+            if( it != map.end() ) s += it->second;
+        }
+
+        return s;
+    }
+};
+
+// benchmark
+
+struct config
+{
+    std::size_t threads;
+    mix const* mix_;
+    double skew;
+    bool bulk;
+};
+
+static bench::common_options const* opts;
+static std::size_t bulk_size;
+static std::size_t latency_sample;
+
+// Latencies are kept apart per operation type, as their distributions differ
+// widely. Bulk lookups are timed per call and reported per key.
+
+enum latency_kind
+{
+    lat_read,
+    lat_write,
+    lat_erase,
+    lat_bulk_read,
+    num_latency_kinds
+};
+
+static char const* const latency_kind_names[ num_latency_kinds ] =
+{
+    "read", "write", "erase", "bulk_read_per_key"
+};
+
+using latency_vectors = std::array<std::vector<double>, num_latency_kinds>;
+
+// Runs ops[first, last) on m, recording the latency of every
+// latency_sample-th call of each kind (a bulk lookup counts as one call).
+
+template<class Map> BOOST_NOINLINE void run_ops( Map& m, op const* first, op const* last, bool bulk, latency_vectors& latencies )
+{
+    std::uint64_t s = 0;
+    std::size_t calls[ num_latency_kinds ] = {};
+
+    if( latency_sample )
+    {
+        // keep vector reallocations out of the timed loop
+        for( auto& v: latencies ) v.reserve( static_cast<std::size_t>( last - first ) / latency_sample + 1 );
+    }
+
+    std::vector<std::uint64_t> batch;
+    batch.reserve( bulk_size );
+
+    auto call = [&]( latency_kind kind, std::size_t num_keys, auto f )
+    {
+        if( latency_sample && ++calls[ kind ] % latency_sample == 0 )
+        {
+            auto t1 = bench::clock_type::now();
+            f();
+            auto t2 = bench::clock_type::now();
+
+            latencies[ kind ].push_back( bench::elapsed_ns( t1, t2 ) / static_cast<double>( num_keys ) );
+        }
+        else
+        {
+            f();
+        }
+    };
+
+    auto flush = [&]
+    {
+        call( lat_bulk_read, batch.size(), [&]{ s += m.read( batch.data(), batch.data() + batch.size() ); } );
+        batch.clear();
+    };
+
+    for( ; first != last; ++first )
+    {
+        std::uint64_t k = first->key;
+
+        switch( first->type )
+        {
+        case op_read:
+
+            if( bulk )
+            {
+                batch.push_back( k );
+                if( batch.size() == bulk_size ) flush();
+            }
+            else
+            {
+                call( lat_read, 1, [&]{ s += m.read( k ); } );
+            }
+
+            break;
+
+        case op_write:
+
+            call( lat_write, 1, [&]{ m.write( k, k ); } );
+            break;
+
+        case op_erase:
+
+            call( lat_erase, 1, [&]{ m.erase( k ); } );
+            break;
+        }
+    }
+
+    if( !batch.empty() ) flush();
+
+    bench::consume( s );
+}
+
+template<class Map> BOOST_NOINLINE void test( bench::reporter& rep, char const* label, std::vector<std::uint64_t> const& keys, std::vector<op> const& ops, config const& cfg )
+{
+    std::ostringstream os;
+
+    os << "threads=" << cfg.threads << ", mix=" << cfg.mix_->name << ", skew=" << cfg.skew << ", " << ( cfg.bulk? "bulk": "single" );
+
+    std::string phase = os.str();
+
+    latency_vectors latencies;
+
+    for( std::size_t r = 0; r < opts->repetitions; ++r )
+    {
+        Map m;
+
+        for( auto k: keys ) m.write( k, k );
+
+        std::vector<latency_vectors> thread_latencies( cfg.threads );
+        std::vector<std::thread> threads;
+
+        std::atomic<std::size_t> ready( 0 );
+        std::atomic<bool> go( false );
+
+        for( std::size_t i = 0; i < cfg.threads; ++i )
+        {
+            threads.emplace_back( [&, i]
+            {
+                op const* first = ops.data() + ops.size() * i / cfg.threads;
+                op const* last = ops.data() + ops.size() * ( i + 1 ) / cfg.threads;
+
+                ++ready;
+                while( !go.load( std::memory_order_acquire ) ) std::this_thread::yield();
+
+                run_ops( m, first, last, cfg.bulk, thread_latencies[ i ] );
+            });
+        }
+
+        while( ready.load() != cfg.threads ) std::this_thread::yield();
+
+        auto t1 = bench::clock_type::now();
+        go.store( true, std::memory_order_release );
+
+        for( auto& th: threads ) th.join();
+
+        auto t2 = bench::clock_type::now();
+
+        rep.sample( label, phase, ops.size(), bench::elapsed_ns( t1, t2 ) );
+
+        for( auto const& tl: thread_latencies )
+        {
+            for( int k = 0; k < num_latency_kinds; ++k )
+            {
+                latencies[ k ].insert( latencies[ k ].end(), tl[ k ].begin(), tl[ k ].end() );
+            }
+        }
+    }
+
+    // kinds not present in the mix (or lookup mode) are not reported
+
+    for( int k = 0; k < num_latency_kinds; ++k )
+    {
+        auto& v = latencies[ k ];
+        if( v.empty() ) continue;
+
+        std::sort( v.begin(), v.end() );
+
+        std::string prefix = std::string( latency_kind_names[ k ] ) + "_latency_";
+
+        rep.metric( label, phase, prefix + "p50_ns", bench::percentile( v, 0.5 ) );
+        rep.metric( label, phase, prefix + "p99_ns", bench::percentile( v, 0.99 ) );
+        rep.metric( label, phase, prefix + "p99.9_ns", bench::percentile( v, 0.999 ) );
+        rep.metric( label, phase, prefix + "max_ns", v.back() );
+    }
+}
+
+int main( int argc, char** argv )
+{
+    bench::command_line cl( argc, argv );
+
+    bench::common_options options( cl, 1'000'000 );
+
+    std::string default_threads = "1";
+
+    for( std::size_t t = 2, hc = std::max( std::thread::hardware_concurrency(), 1u ); t <= hc; t *= 2 )
+    {
+        default_threads += "," + std::to_string( t );
+    }
+
+    std::string threads_arg = cl.get( "threads", default_threads, "comma-separated list of thread counts" );
+    std::size_t num_ops = cl.get( "ops", std::size_t( 10'000'000 ), "total number of operations, split among threads" );
+    std::string mixes_arg = cl.get( "mix", "100/0/0,90/5/5,50/25/25", "comma-separated list of read/write/erase percentages" );
+    std::string skews_arg = cl.get( "skew", "0,0.99", "comma-separated list of Zipf exponents for key selection (0: uniform)" );
+    std::string modes_arg = cl.get( "mode", "single,bulk", "lookup mode: single (visit(k)) and/or bulk (visit(first, last))" );
+    bulk_size = cl.get( "bulk-size", std::size_t( 16 ), "number of keys per bulk lookup" );
+    latency_sample = cl.get( "latency-sample", std::size_t( 64 ), "record the latency of one in every this many calls (0: none)" );
+
+    std::vector<std::size_t> thread_counts;
+
+    for( auto const& x: bench::split( threads_arg ) )
+    {
+        auto t = static_cast<std::size_t>( std::strtoull( x.c_str(), nullptr, 10 ) );
+
+        if( t == 0 ) cl.error( "invalid thread count " + x );
+        else thread_counts.push_back( t );
+    }
+
+    std::vector<mix> mixes;
+
+    for( auto const& x: bench::split( mixes_arg ) )
+    {
+        auto v = bench::split( x, '/' );
+
+        if( v.size() != 3 )
+        {
+            cl.error( "invalid mix " + x );
+            continue;
+        }
+
+        mix m = { x,
+            static_cast<unsigned>( std::strtoul( v[ 0 ].c_str(), nullptr, 10 ) ),
+            static_cast<unsigned>( std::strtoul( v[ 1 ].c_str(), nullptr, 10 ) ),
+            static_cast<unsigned>( std::strtoul( v[ 2 ].c_str(), nullptr, 10 ) ) };
+
+        if( m.read + m.write + m.erase != 100 ) cl.error( "mix percentages must add up to 100: " + x );
+        else mixes.push_back( m );
+    }
+
+    std::vector<double> skews;
+
+    for( auto const& x: bench::split( skews_arg ) )
+    {
+        char* end = nullptr;
+        double s = std::strtod( x.c_str(), &end );
+
+        if( x.empty() || *end != '\0' || s < 0 ) cl.error( "invalid skew " + x );
+        else skews.push_back( s );
+    }
+
+    std::vector<bool> modes;
+
+    for( auto const& x: bench::split( modes_arg ) )
+    {
+        if( x == "single" ) modes.push_back( false );
+        else if( x == "bulk" ) modes.push_back( true );
+        else cl.error( "unknown lookup mode " + x );
+    }
+
+    if( bulk_size == 0 ) cl.error( "--bulk-size must be positive" );
+
+    if( !cl.check() ) return 1;
+
+    opts = &options;
+
+    bench::reporter rep( "concurrent" );
+
+    options.describe( rep );
+    rep.param( "num_ops", num_ops );
+    rep.param( "bulk_size", bulk_size );
+    rep.param( "latency_sample", latency_sample );
+
+    auto keys = bench::make_keys( options.distribution, options.n, options.seed );
+
+    for( auto const& m: mixes )
+    {
+        for( double skew: skews )
+        {
+            auto ops = make_ops( keys, num_ops, m, skew, options.seed + 1 );
+
+            for( bool bulk: modes )
+            {
+                // bulk lookup makes no difference without reads
+                if( bulk && m.read == 0 ) continue;
+
+                for( auto t: thread_counts )
+                {
+                    config cfg = { t, &m, skew, bulk };
+
+                    if( options.selected( "boost::concurrent_flat_map" ) )
+                        test< concurrent_map< boost::concurrent_flat_map<std::uint64_t, std::uint64_t> > >( rep, "boost::concurrent_flat_map", keys, ops, cfg );
+
+                    if( options.selected( "boost::concurrent_node_map" ) )
+                        test< concurrent_map< boost::concurrent_node_map<std::uint64_t, std::uint64_t> > >( rep, "boost::concurrent_node_map", keys, ops, cfg );
+
+                    if( options.selected( "std::mutex + boost::unordered_flat_map" ) )
+                        test< locked_flat_map >( rep, "std::mutex + boost::unordered_flat_map", keys, ops, cfg );
+                }
+            }
+        }
+    }
+
+    return rep.write( options.format, options.output )? 0: 1;
+}
@@ -0,0 +1,715 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Shared infrastructure for the benchmark programs: command line parsing,
+// key generation, repeated timing with median/variance summaries and
+// text/JSON/CSV reporting.
+
+#ifndef BOOST_UNORDERED_BENCHMARK_HARNESS_HPP
+#define BOOST_UNORDERED_BENCHMARK_HARNESS_HPP
+
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+// command line
+
+// Arguments are of the form --name=value (or --name, meaning "true");
+// get() consumes them so that unknown ones can be reported afterwards.
+
+class command_line
+{
+private:
+
+    std::string program_;
+    std::map<std::string, std::string> args_;
+    std::vector<std::string> errors_;
+    std::vector<std::string> help_;
+
+public:
+
+    command_line( int argc, char** argv ): program_( argc > 0? argv[ 0 ]: "benchmark" )
+    {
+        for( int i = 1; i < argc; ++i )
+        {
+            std::string arg = argv[ i ];
+
+            if( arg.compare( 0, 2, "--" ) != 0 )
+            {
+                errors_.push_back( "unexpected argument " + arg );
+                continue;
+            }
+
+            auto pos = arg.find( '=' );
+
+            if( pos == std::string::npos )
+            {
+                args_[ arg.substr( 2 ) ] = "true";
+            }
+            else
+            {
+                args_[ arg.substr( 2, pos - 2 ) ] = arg.substr( pos + 1 );
+            }
+        }
+    }
+
+    std::string get( std::string const& name, std::string const& def, std::string const& help )
+    {
+        help_.push_back( "  --" + name + "=" + ( def.empty()? "...": def ) + "\n      " + help );
+
+        auto it = args_.find( name );
+        if( it == args_.end() ) return def;
+
+        std::string res = it->second;
+        args_.erase( it );
+        return res;
+    }
+
+    std::string get( std::string const& name, char const* def, std::string const& help )
+    {
+        return get( name, std::string( def ), help );
+    }
+
+    std::size_t get( std::string const& name, std::size_t def, std::string const& help )
+    {
+        std::string s = get( name, std::to_string( def ), help );
+
+        char* end = nullptr;
+        unsigned long long x = std::strtoull( s.c_str(), &end, 10 );
+
+        if( s.empty() || *end != '\0' )
+        {
+            errors_.push_back( "invalid value for --" + name + ": " + s );
+            return def;
+        }
+
+        return static_cast<std::size_t>( x );
+    }
+
+    double get( std::string const& name, double def, std::string const& help )
+    {
+        std::ostringstream os;
+        os << def;
+
+        std::string s = get( name, os.str(), help );
+
+        char* end = nullptr;
+        double x = std::strtod( s.c_str(), &end );
+
+        if( s.empty() || *end != '\0' )
+        {
+            errors_.push_back( "invalid value for --" + name + ": " + s );
+            return def;
+        }
+
+        return x;
+    }
+
+    void error( std::string const& msg )
+    {
+        errors_.push_back( msg );
+    }
+
+    // To be called after all options have been retrieved: prints usage and
+    // returns false on unknown options, invalid values or --help.
+
+    bool check()
+    {
+        bool help = args_.erase( "help" ) != 0;
+
+        for( auto const& x: args_ )
+        {
+            errors_.push_back( "unknown option --" + x.first );
+        }
+
+        for( auto const& x: errors_ )
+        {
+            std::cerr << program_ << ": " << x << "\n";
+        }
+
+        if( help || !errors_.empty() )
+        {
+            std::cerr << "Usage: " << program_ << " [options]\n";
+
+            for( auto const& x: help_ ) std::cerr << x << "\n";
+
+            return false;
+        }
+
+        return true;
+    }
+};
+
+// timing
+
+using clock_type = std::chrono::steady_clock;
+
+inline double elapsed_ns( clock_type::time_point t1, clock_type::time_point t2 )
+{
+    return std::chrono::duration<double, std::nano>( t2 - t1 ).count();
+}
+
+// keeps computed results from being optimized away
+inline void consume( std::uint64_t x )
+{
+    static std::uint64_t volatile sink;
+    sink = sink + x;
+}
+
+// key generation
+
+// consecutive: 1, 2, 3, ...
+// random: splitmix64 output
+// reversed: byte-reversed consecutive integers, hard on hash functions that
+// only look at the low bits
+
+inline bool valid_distribution( std::string const& name )
+{
+    return name == "consecutive" || name == "random" || name == "reversed";
+}
+
+inline std::vector<std::uint64_t> make_keys( std::string const& distribution, std::size_t n, std::uint64_t seed = 0 )
+{
+    std::vector<std::uint64_t> res;
+    res.reserve( n );
+
+    if( distribution == "consecutive" )
+    {
+        for( std::size_t i = 1; i <= n; ++i ) res.push_back( i );
+    }
+    else if( distribution == "random" )
+    {
+        boost::detail::splitmix64 rng( seed );
+        for( std::size_t i = 1; i <= n; ++i ) res.push_back( rng() );
+    }
+    else if( distribution == "reversed" )
+    {
+        for( std::size_t i = 1; i <= n; ++i ) res.push_back( boost::endian::endian_reverse( static_cast<std::uint64_t>( i ) ) );
+    }
+    else
+    {
+        throw std::invalid_argument( "unknown key distribution " + distribution );
+    }
+
+    return res;
+}
+
+inline std::string make_string_key( std::uint64_t x )
+{
+    char buffer[ 64 ];
+    std::snprintf( buffer, sizeof( buffer ), "pfx_%llu_sfx", static_cast<unsigned long long>( x ) );
+
+    return buffer;
+}
+
+// Zipf-distributed ranks in [0, n): rank i is drawn with probability
+// proportional to 1 / (i + 1)^s; s = 0 gives a uniform distribution
+
+class zipf_generator
+{
+private:
+
+    std::vector<double> cdf_;
+
+public:
+
+    zipf_generator( std::size_t n, double s ): cdf_( n )
+    {
+        double sum = 0;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            sum += 1.0 / std::pow( static_cast<double>( i + 1 ), s );
+            cdf_[ i ] = sum;
+        }
+
+        for( auto& x: cdf_ ) x /= sum;
+    }
+
+    template<class Rng> std::size_t operator()( Rng& rng ) const
+    {
+        double u = static_cast<double>( rng() >> 11 ) * 0x1.0p-53;
+
+        auto it = std::upper_bound( cdf_.begin(), cdf_.end(), u );
+        if( it == cdf_.end() ) --it;
+
+        return static_cast<std::size_t>( it - cdf_.begin() );
+    }
+};
+
+// splits a comma-separated list
+inline std::vector<std::string> split( std::string const& s, char sep = ',' )
+{
+    std::vector<std::string> res;
+    std::string::size_type pos = 0;
+
+    for( ;; )
+    {
+        auto next = s.find( sep, pos );
+        res.push_back( s.substr( pos, next - pos ) );
+
+        if( next == std::string::npos ) break;
+        pos = next + 1;
+    }
+
+    return res;
+}
+
+// statistics over repetitions
+
+struct summary
+{
+    double median;
+    double mean;
+    double variance; // sample variance
+    double stddev;
+    double min;
+    double max;
+};
+
+inline summary summarize( std::vector<double> v )
+{
+    summary res = {};
+    if( v.empty() ) return res;
+
+    std::sort( v.begin(), v.end() );
+
+    std::size_t n = v.size();
+
+    res.median = n % 2? v[ n / 2 ]: ( v[ n / 2 - 1 ] + v[ n / 2 ] ) / 2;
+    res.min = v.front();
+    res.max = v.back();
+
+    double sum = 0;
+    for( double x: v ) sum += x;
+    res.mean = sum / static_cast<double>( n );
+
+    if( n > 1 )
+    {
+        double sq = 0;
+        for( double x: v ) sq += ( x - res.mean ) * ( x - res.mean );
+        res.variance = sq / static_cast<double>( n - 1 );
+    }
+
+    res.stddev = std::sqrt( res.variance );
+
+    return res;
+}
+
+// q-th quantile (0 <= q <= 1) of sorted v, nearest-rank method
+inline double percentile( std::vector<double> const& v, double q )
+{
+    if( v.empty() ) return 0;
+
+    auto i = static_cast<std::size_t>( std::ceil( q * static_cast<double>( v.size() ) ) );
+    return v[ i > 0? i - 1: 0 ];
+}
+
+// reporting
+
+// Samples are recorded per (container, phase) pair, one per repetition;
+// parameters describe the run and are emitted along with every result.
+
+class reporter
+{
+private:
+
+    struct metric_value
+    {
+        std::string name;
+        double value;
+        bool integral; // byte counts, indices etc. are printed in full
+
+        void print( std::ostream& os, int precision ) const
+        {
+            if( integral ) os << static_cast<unsigned long long>( value );
+            else os << std::defaultfloat << std::setprecision( precision ) << value;
+        }
+    };
+
+    struct entry
+    {
+        std::string container;
+        std::string phase;
+        std::size_t ops;
+        std::vector<double> samples_ns;
+        std::vector<metric_value> metrics;
+    };
+
+    std::string benchmark_;
+    std::vector<std::pair<std::string, std::string>> params_; // name, JSON value
+    std::vector<entry> entries_;
+
+    entry& find_entry( std::string const& container, std::string const& phase )
+    {
+        for( auto& x: entries_ )
+        {
+            if( x.container == container && x.phase == phase ) return x;
+        }
+
+        entries_.push_back( { container, phase, 0, {}, {} } );
+        return entries_.back();
+    }
+
+    static std::string json_string( std::string const& s )
+    {
+        std::string res = "\"";
+
+        for( char ch: s )
+        {
+            if( ch == '"' || ch == '\\' ) res += '\\';
+            res += ch;
+        }
+
+        return res + "\"";
+    }
+
+    static std::string csv_string( std::string const& s )
+    {
+        if( s.find_first_of( ",\"" ) == std::string::npos ) return s;
+
+        std::string res = "\"";
+
+        for( char ch: s )
+        {
+            if( ch == '"' ) res += '"';
+            res += ch;
+        }
+
+        return res + "\"";
+    }
+
+    static std::string unquote( std::string const& s )
+    {
+        return s.size() >= 2 && s.front() == '"'? s.substr( 1, s.size() - 2 ): s;
+    }
+
+    static double per_op( double ns, std::size_t ops )
+    {
+        return ops? ns / static_cast<double>( ops ): 0.0;
+    }
+
+    // millions of operations per second
+    static double mops( double ns, std::size_t ops )
+    {
+        return ns > 0? static_cast<double>( ops ) * 1e3 / ns: 0.0;
+    }
+
+    void write_text( std::ostream& os ) const
+    {
+        os << benchmark_;
+
+        for( auto const& x: params_ ) os << ", " << x.first << "=" << unquote( x.second );
+
+        os << "\n\n";
+
+        // group results by container, in order of first appearance
+
+        std::vector<std::string> containers;
+
+        for( auto const& x: entries_ )
+        {
+            if( std::find( containers.begin(), containers.end(), x.container ) == containers.end() )
+            {
+                containers.push_back( x.container );
+            }
+        }
+
+        std::size_t width = 0;
+
+        for( auto const& x: entries_ ) width = std::max( width, x.phase.size() + 2 );
+
+        for( auto const& c: containers )
+        {
+            os << c << ":\n\n";
+
+            for( auto const& x: entries_ )
+            {
+                if( x.container == c ) write_text( os, x, width );
+            }
+
+            os << "\n";
+        }
+    }
+
+    static void write_text( std::ostream& os, entry const& x, std::size_t width )
+    {
+        os << "  " << std::setw( static_cast<int>( width ) ) << std::left << ( x.phase + ": " ) << std::right;
+
+        if( !x.samples_ns.empty() )
+        {
+            summary s = summarize( x.samples_ns );
+
+            os << std::fixed << std::setprecision( 2 )
+                << std::setw( 10 ) << s.median / 1e6 << " ms (stddev "
+                << s.stddev / 1e6 << " ms), " << per_op( s.median, x.ops ) << " ns/op, "
+                << mops( s.median, x.ops ) << " Mops/s";
+        }
+
+        for( auto const& m: x.metrics )
+        {
+            os << ( &m == &x.metrics.front() && x.samples_ns.empty()? "": ", " ) << m.name << " ";
+            m.print( os, 6 );
+        }
+
+        os << std::defaultfloat << std::setprecision( 6 ) << "\n";
+    }
+
+    void write_json( std::ostream& os ) const
+    {
+        os << std::setprecision( 12 );
+        os << "{\n  \"benchmark\": " << json_string( benchmark_ ) << ",\n  \"params\": {";
+
+        for( auto const& x: params_ )
+        {
+            os << ( &x == &params_.front()? " ": ", " ) << json_string( x.first ) << ": " << x.second;
+        }
+
+        os << " },\n  \"results\": [\n";
+
+        for( auto const& x: entries_ )
+        {
+            os << "    { \"container\": " << json_string( x.container ) << ", \"phase\": " << json_string( x.phase );
+
+            if( !x.samples_ns.empty() )
+            {
+                summary s = summarize( x.samples_ns );
+
+                os
+                    << ", \"ops\": " << x.ops
+                    << ", \"repetitions\": " << x.samples_ns.size()
+                    << ", \"median_ns\": " << s.median
+                    << ", \"mean_ns\": " << s.mean
+                    << ", \"variance_ns2\": " << s.variance
+                    << ", \"stddev_ns\": " << s.stddev
+                    << ", \"min_ns\": " << s.min
+                    << ", \"max_ns\": " << s.max
+                    << ", \"ns_per_op\": " << per_op( s.median, x.ops )
+                    << ", \"mops\": " << mops( s.median, x.ops )
+                    << ", \"samples_ns\": [";
+
+                for( auto const& t: x.samples_ns ) os << ( &t == &x.samples_ns.front()? "": ", " ) << t;
+
+                os << "]";
+            }
+
+            for( auto const& m: x.metrics )
+            {
+                os << ", " << json_string( m.name ) << ": ";
+                m.print( os, 12 );
+            }
+
+            os << " }" << ( &x == &entries_.back()? "": "," ) << "\n";
+        }
+
+        os << "  ]\n}\n";
+    }
+
+    void write_csv( std::ostream& os ) const
+    {
+        os << std::setprecision( 12 );
+        os << "benchmark";
+
+        for( auto const& x: params_ ) os << "," << csv_string( x.first );
+
+        os << ",container,phase,ops,samples,median_ns,mean_ns,variance_ns2,stddev_ns,min_ns,max_ns,ns_per_op,mops,metrics\n";
+
+        for( auto const& x: entries_ )
+        {
+            os << csv_string( benchmark_ );
+
+            for( auto const& p: params_ ) os << "," << csv_string( unquote( p.second ) );
+
+            os << "," << csv_string( x.container ) << "," << csv_string( x.phase );
+
+            summary s = summarize( x.samples_ns );
+
+            os
+                << "," << x.ops
+                << "," << x.samples_ns.size()
+                << "," << s.median
+                << "," << s.mean
+                << "," << s.variance
+                << "," << s.stddev
+                << "," << s.min
+                << "," << s.max
+                << "," << per_op( s.median, x.ops )
+                << "," << mops( s.median, x.ops )
+                << ",";
+
+            std::ostringstream ms;
+            ms << std::setprecision( 12 );
+
+            for( auto const& m: x.metrics )
+            {
+                ms << ( &m == &x.metrics.front()? "": ";" ) << m.name << "=";
+                m.print( ms, 12 );
+            }
+
+            os << csv_string( ms.str() ) << "\n";
+        }
+    }
+
+public:
+
+    explicit reporter( std::string const& benchmark ): benchmark_( benchmark )
+    {
+    }
+
+    void param( std::string const& name, std::string const& value )
+    {
+        params_.emplace_back( name, json_string( value ) );
+    }
+
+    void param( std::string const& name, char const* value )
+    {
+        param( name, std::string( value ) );
+    }
+
+    void param( std::string const& name, std::size_t value )
+    {
+        params_.emplace_back( name, std::to_string( value ) );
+    }
+
+    void param( std::string const& name, double value )
+    {
+        std::ostringstream os;
+        os << value;
+
+        params_.emplace_back( name, os.str() );
+    }
+
+    // one sample per call, typically one per repetition
+    void sample( std::string const& container, std::string const& phase, std::size_t ops, double ns )
+    {
+        auto& e = find_entry( container, phase );
+
+        e.ops = ops;
+        e.samples_ns.push_back( ns );
+    }
+
+    // additional per-result figures (percentiles, bytes...)
+    void metric( std::string const& container, std::string const& phase, std::string const& name, double value, bool integral = false )
+    {
+        auto& e = find_entry( container, phase );
+
+        for( auto& m: e.metrics )
+        {
+            if( m.name == name )
+            {
+                m.value = value;
+                m.integral = integral;
+                return;
+            }
+        }
+
+        e.metrics.push_back( { name, value, integral } );
+    }
+
+    void metric( std::string const& container, std::string const& phase, std::string const& name, std::size_t value )
+    {
+        metric( container, phase, name, static_cast<double>( value ), true );
+    }
+
+    static bool valid_format( std::string const& format )
+    {
+        return format == "text" || format == "json" || format == "csv";
+    }
+
+    void write( std::ostream& os, std::string const& format ) const
+    {
+        if( format == "json" ) write_json( os );
+        else if( format == "csv" ) write_csv( os );
+        else write_text( os );
+    }
+
+    // writes to the given file, or to std::cout if empty
+    bool write( std::string const& format, std::string const& output ) const
+    {
+        if( output.empty() )
+        {
+            write( std::cout, format );
+            return true;
+        }
+
+        std::ofstream os( output );
+
+        if( !os )
+        {
+            std::cerr << "Cannot open " << output << "\n";
+            return false;
+        }
+
+        write( os, format );
+        return static_cast<bool>( os );
+    }
+};
+
+// options shared by all harness-based benchmarks
+
+struct common_options
+{
+    std::size_t n;
+    std::size_t repetitions;
+    std::string distribution;
+    std::uint64_t seed;
+    std::string filter;
+    std::string format;
+    std::string output;
+    bool has_repetitions;
+
+    // benchmarks whose measurements are deterministic pass with_repetitions
+    // = false, so that --repetitions is rejected as an unknown option
+
+    common_options( command_line& cl, std::size_t default_n, bool with_repetitions = true ): has_repetitions( with_repetitions )
+    {
+        n = cl.get( "n", default_n, "number of elements" );
+        repetitions = with_repetitions? cl.get( "repetitions", std::size_t( 5 ), "number of repetitions; the median and variance are reported" ): 1;
+        distribution = cl.get( "distribution", "random", "key distribution: consecutive, random or reversed" );
+        seed = cl.get( "seed", std::size_t( 0 ), "seed for random key generation" );
+        filter = cl.get( "filter", "", "only run containers whose name contains this string" );
+        format = cl.get( "format", "text", "output format: text, json or csv" );
+        output = cl.get( "output", "", "output file (default: standard output)" );
+
+        if( n == 0 ) cl.error( "--n must be positive" );
+        if( repetitions == 0 ) cl.error( "--repetitions must be positive" );
+        if( !valid_distribution( distribution ) ) cl.error( "unknown key distribution " + distribution );
+        if( !reporter::valid_format( format ) ) cl.error( "unknown output format " + format );
+    }
+
+    bool selected( std::string const& container ) const
+    {
+        return filter.empty() || container.find( filter ) != std::string::npos;
+    }
+
+    void describe( reporter& rep ) const
+    {
+        rep.param( "n", n );
+        if( has_repetitions ) rep.param( "repetitions", repetitions );
+        rep.param( "distribution", distribution );
+        rep.param( "seed", static_cast<std::size_t>( seed ) );
+    }
+};
+
+} // namespace bench
+
+#endif // #ifndef BOOST_UNORDERED_BENCHMARK_HARNESS_HPP
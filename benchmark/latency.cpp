@@ -0,0 +1,296 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Per-operation latency distribution of insertion, lookup and erasure, so
+// that pauses caused by rehashing show up in the tail percentiles rather
+// than being averaged away. Run with --help for the available options.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include "harness.hpp"
+#include <boost/unordered_map.hpp>
+#include <boost/unordered/unordered_node_map.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/config.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+# include <intrin.h>
+# define HAVE_RDTSC
+#elif ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+# include <x86intrin.h>
+# define HAVE_RDTSC
+#endif
+
+// timers: start() and stop() bracket the timed operation
+
+struct steady_timer
+{
+    using tick = bench::clock_type::time_point;
+
+    static tick start()
+    {
+        return bench::clock_type::now();
+    }
+
+    static tick stop()
+    {
+        return bench::clock_type::now();
+    }
+
+    static double ns( tick t1, tick t2 )
+    {
+        return bench::elapsed_ns( t1, t2 );
+    }
+};
+
+#ifdef HAVE_RDTSC
+
+struct tsc_timer
+{
+    using tick = std::uint64_t;
+
+    static double ns_per_tick;
+
+    // rdtsc is not serializing: the leading lfence keeps it from executing
+    // before preceding instructions (the previous operation) complete
+
+    static tick start()
+    {
+        _mm_lfence();
+        tick t = __rdtsc();
+        _mm_lfence();
+        return t;
+    }
+
+    // rdtscp waits for preceding instructions (the timed operation) to
+    // complete, and the trailing lfence keeps subsequent ones from starting
+    // before the counter is read
+
+    static tick stop()
+    {
+        unsigned int aux;
+        tick t = __rdtscp( &aux );
+        _mm_lfence();
+        return t;
+    }
+
+    static double ns( tick t1, tick t2 )
+    {
+        return static_cast<double>( t2 - t1 ) * ns_per_tick;
+    }
+
+    // TSC frequency is measured against steady_clock over a short interval
+    static void calibrate()
+    {
+        auto t1 = bench::clock_type::now();
+        auto c1 = start();
+
+        while( bench::elapsed_ns( t1, bench::clock_type::now() ) < 50e6 );
+
+        auto c2 = stop();
+        auto t2 = bench::clock_type::now();
+
+        ns_per_tick = bench::elapsed_ns( t1, t2 ) / static_cast<double>( c2 - c1 );
+    }
+};
+
+double tsc_timer::ns_per_tick = 1.0;
+
+#endif
+
+// cost of taking a measurement, reported so that it can be discounted
+
+template<class Timer> static double timer_overhead()
+{
+    std::vector<double> v;
+    v.reserve( 100'000 );
+
+    for( int i = 0; i < 100'000; ++i )
+    {
+        auto t1 = Timer::start();
+        auto t2 = Timer::stop();
+
+        v.push_back( Timer::ns( t1, t2 ) );
+    }
+
+    std::sort( v.begin(), v.end() );
+    return bench::percentile( v, 0.5 );
+}
+
+// benchmark
+
+static bench::common_options const* opts;
+static std::size_t sample_period;
+
+struct phase_latencies
+{
+    std::vector<double> latencies;
+    std::size_t max_index = 0; // operation at which the maximum was observed
+    double max = -1;
+};
+
+// Runs f( i ) for i in [0, n), timing one in every sample_period calls.
+
+template<class Timer, class F> BOOST_NOINLINE double timed_loop( std::size_t n, phase_latencies& pl, F f )
+{
+    auto t0 = bench::clock_type::now();
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        if( i % sample_period == 0 )
+        {
+            auto t1 = Timer::start();
+            f( i );
+            auto t2 = Timer::stop();
+
+            double ns = Timer::ns( t1, t2 );
+
+            pl.latencies.push_back( ns );
+
+            if( ns > pl.max )
+            {
+                pl.max = ns;
+                pl.max_index = i;
+            }
+        }
+        else
+        {
+            f( i );
+        }
+    }
+
+    return bench::elapsed_ns( t0, bench::clock_type::now() );
+}
+
+static void report( bench::reporter& rep, char const* label, char const* phase, phase_latencies& pl )
+{
+    std::sort( pl.latencies.begin(), pl.latencies.end() );
+
+    rep.metric( label, phase, "latency_p50_ns", bench::percentile( pl.latencies, 0.5 ) );
+    rep.metric( label, phase, "latency_p99_ns", bench::percentile( pl.latencies, 0.99 ) );
+    rep.metric( label, phase, "latency_p99.9_ns", bench::percentile( pl.latencies, 0.999 ) );
+    rep.metric( label, phase, "latency_max_ns", pl.latencies.empty()? 0.0: pl.latencies.back() );
+    rep.metric( label, phase, "latency_max_at", pl.max_index );
+}
+
+template<class Timer, class Map> BOOST_NOINLINE void test( bench::reporter& rep, char const* label, std::vector<std::uint64_t> const& keys )
+{
+    if( !opts->selected( label ) ) return;
+
+    phase_latencies insertion, lookup, erasure;
+
+    // keep vector reallocations out of the timed loops
+    std::size_t const num_samples = opts->repetitions * ( keys.size() / sample_period + 1 );
+
+    for( auto* pl: { &insertion, &lookup, &erasure } )
+    {
+        pl->latencies.reserve( num_samples );
+    }
+
+    for( std::size_t r = 0; r < opts->repetitions; ++r )
+    {
+        Map map;
+        std::uint64_t s = 0;
+
+        double t = timed_loop<Timer>( keys.size(), insertion, [&]( std::size_t i )
+        {
+            map.insert( { keys[ i ], i } );
+        });
+
+        rep.sample( label, "insert", keys.size(), t );
+
+        t = timed_loop<Timer>( keys.size(), lookup, [&]( std::size_t i )
+        {
+            auto it = map.find( keys[ i ] );
+            if( it != map.end() ) s += it->second;
+        });
+
+        rep.sample( label, "successful lookup", keys.size(), t );
+
+        t = timed_loop<Timer>( keys.size(), erasure, [&]( std::size_t i )
+        {
+            map.erase( keys[ i ] );
+        });
+
+        rep.sample( label, "erase", keys.size(), t );
+
+        bench::consume( s + map.size() );
+    }
+
+    report( rep, label, "insert", insertion );
+    report( rep, label, "successful lookup", lookup );
+    report( rep, label, "erase", erasure );
+}
+
+template<class Timer> static void run( bench::reporter& rep, std::vector<std::uint64_t> const& keys )
+{
+    using K = std::uint64_t;
+    using V = std::size_t;
+
+    rep.param( "timer_overhead_ns", timer_overhead<Timer>() );
+
+    test< Timer, std::unordered_map<K, V> >( rep, "std::unordered_map", keys );
+    test< Timer, boost::unordered_map<K, V> >( rep, "boost::unordered_map", keys );
+    test< Timer, boost::unordered_node_map<K, V> >( rep, "boost::unordered_node_map", keys );
+    test< Timer, boost::unordered_flat_map<K, V> >( rep, "boost::unordered_flat_map", keys );
+}
+
+int main( int argc, char** argv )
+{
+    bench::command_line cl( argc, argv );
+
+    bench::common_options options( cl, 1'000'000 );
+
+    sample_period = cl.get( "sample", std::size_t( 1 ), "time one in every this many operations" );
+
+#ifdef HAVE_RDTSC
+    std::string timer = cl.get( "timer", "tsc", "timer: tsc (time stamp counter) or steady (std::chrono::steady_clock)" );
+#else
+    std::string timer = cl.get( "timer", "steady", "timer: steady (std::chrono::steady_clock)" );
+#endif
+
+    if( sample_period == 0 ) cl.error( "--sample must be positive" );
+
+#ifdef HAVE_RDTSC
+    if( timer != "tsc" && timer != "steady" ) cl.error( "unknown timer " + timer );
+#else
+    if( timer != "steady" ) cl.error( "unknown timer " + timer );
+#endif
+
+    if( !cl.check() ) return 1;
+
+    opts = &options;
+
+    bench::reporter rep( "latency" );
+
+    options.describe( rep );
+    rep.param( "sample", sample_period );
+    rep.param( "timer", timer );
+
+    auto keys = bench::make_keys( options.distribution, options.n, options.seed );
+
+#ifdef HAVE_RDTSC
+
+    if( timer == "tsc" )
+    {
+        tsc_timer::calibrate();
+        run<tsc_timer>( rep, keys );
+    }
+    else
+
+#endif
+
+    {
+        run<steady_timer>( rep, keys );
+    }
+
+    return rep.write( options.format, options.output )? 0: 1;
+}
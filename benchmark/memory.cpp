@@ -0,0 +1,401 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Memory consumption of closed-addressing, open-addressing and concurrent
+// maps and sets, measured with a counting allocator: bytes per element held
+// and peak bytes per element (which includes the old and new bucket arrays
+// alive at the same time during rehashing) at selected sizes and right before
+// and after every growth, plus allocation counts. Run with --help for the
+// available options.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include "harness.hpp"
+#include <boost/unordered_map.hpp>
+#include <boost/unordered/unordered_node_map.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <boost/unordered/unordered_node_set.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include <boost/unordered/concurrent_flat_cache.hpp>
+#include <boost/unordered/sharded_flat_map.hpp>
+#include <boost/config.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// counting allocator
+
+static std::size_t s_live_bytes = 0;
+static std::size_t s_peak_bytes = 0;
+static std::size_t s_alloc_count = 0;
+static std::size_t s_live_alloc_count = 0;
+
+template<class T> struct allocator
+{
+    using value_type = T;
+
+    allocator() = default;
+
+    template<class U> allocator( allocator<U> const & ) noexcept
+    {
+    }
+
+    template<class U> bool operator==( allocator<U> const & ) const noexcept
+    {
+        return true;
+    }
+
+    template<class U> bool operator!=( allocator<U> const& ) const noexcept
+    {
+        return false;
+    }
+
+    T* allocate( std::size_t n ) const
+    {
+        s_live_bytes += n * sizeof(T);
+        s_peak_bytes = std::max( s_peak_bytes, s_live_bytes );
+        s_alloc_count++;
+        s_live_alloc_count++;
+
+        return std::allocator<T>().allocate( n );
+    }
+
+    void deallocate( T* p, std::size_t n ) const noexcept
+    {
+        s_live_bytes -= n * sizeof(T);
+        s_live_alloc_count--;
+
+        std::allocator<T>().deallocate( p, n );
+    }
+};
+
+static void reset_counters()
+{
+    s_live_bytes = 0;
+    s_peak_bytes = 0;
+    s_alloc_count = 0;
+    s_live_alloc_count = 0;
+}
+
+// memory_usage(), where available, is reported for comparison
+
+template<class Map, class = void> struct has_memory_usage: std::false_type
+{
+};
+
+template<class Map> struct has_memory_usage<Map, decltype( (void)std::declval<Map const&>().memory_usage() )>: std::true_type
+{
+};
+
+// benchmark
+
+static std::size_t num_elements;
+static std::vector<std::size_t> sizes;
+
+// Containers are default-constructed, filled with emplace and checked for
+// growth through bucket_count() unless specialized below.
+
+template<class Map> struct container_traits
+{
+    static Map make()
+    {
+        return Map();
+    }
+
+    static void insert( Map& map, std::uint64_t k, std::size_t i )
+    {
+        if constexpr( std::is_same<typename Map::key_type, typename Map::value_type>::value )
+        {
+            map.emplace( k );
+        }
+        else
+        {
+            map.emplace( k, i );
+        }
+    }
+
+    static std::size_t bucket_count( Map const& map )
+    {
+        return map.bucket_count();
+    }
+};
+
+// Fixed capacity, set to the number of elements: never grows.
+
+template<class K, class V, class H, class P, class A> struct container_traits< boost::concurrent_flat_cache<K, V, H, P, A> >
+{
+    using map_type = boost::concurrent_flat_cache<K, V, H, P, A>;
+
+    static map_type make()
+    {
+        return map_type( num_elements );
+    }
+
+    static void insert( map_type& map, std::uint64_t k, std::size_t i )
+    {
+        map.emplace( k, i );
+    }
+
+    static std::size_t bucket_count( map_type const& map )
+    {
+        return map.capacity();
+    }
+};
+
+// Growth of any shard is reported. The shard array itself is not allocated
+// through the container allocator, so it only shows up in memory_usage().
+
+static constexpr std::size_t num_shards = 16;
+
+template<class K, class V, class H, class P, class A> struct container_traits< boost::unordered::sharded_flat_map<K, V, H, P, A> >
+{
+    using map_type = boost::unordered::sharded_flat_map<K, V, H, P, A>;
+
+    static map_type make()
+    {
+        return map_type( num_shards );
+    }
+
+    static void insert( map_type& map, std::uint64_t k, std::size_t i )
+    {
+        map.try_emplace( k, i );
+    }
+
+    static std::size_t bucket_count( map_type const& map )
+    {
+        std::size_t res = 0;
+
+        for( std::size_t j = 0; j < map.shard_count(); ++j )
+        {
+            res += map.shard( j ).bucket_count();
+        }
+
+        return res;
+    }
+};
+
+struct snapshot
+{
+    std::size_t size;
+    std::size_t bucket_count;
+    std::size_t live_bytes;
+    std::size_t live_allocs;
+    std::size_t allocs;
+    std::size_t memory_usage;
+};
+
+template<class Map> static snapshot take_snapshot( Map const& map )
+{
+    std::size_t mu = 0;
+
+    if constexpr( has_memory_usage<Map>::value )
+    {
+        mu = map.memory_usage().total;
+    }
+
+    return { map.size(), container_traits<Map>::bucket_count( map ), s_live_bytes, s_live_alloc_count, s_alloc_count, mu };
+}
+
+template<class Map> static void record( bench::reporter& rep, char const* label, std::string const& phase, snapshot const& s, std::size_t peak_bytes )
+{
+    double size = static_cast<double>( std::max<std::size_t>( s.size, 1 ) );
+
+    rep.metric( label, phase, "bytes_per_element", static_cast<double>( s.live_bytes ) / size );
+    rep.metric( label, phase, "peak_bytes_per_element", static_cast<double>( peak_bytes ) / size );
+    rep.metric( label, phase, "live_bytes", s.live_bytes );
+    rep.metric( label, phase, "peak_bytes", peak_bytes );
+    rep.metric( label, phase, "live_allocations", s.live_allocs );
+    rep.metric( label, phase, "allocations", s.allocs );
+    rep.metric( label, phase, "bucket_count", s.bucket_count );
+
+    if constexpr( has_memory_usage<Map>::value )
+    {
+        rep.metric( label, phase, "memory_usage_bytes", s.memory_usage );
+    }
+}
+
+template<class Map> BOOST_NOINLINE void test( bench::common_options const& opts, bench::reporter& rep, char const* label, std::vector<std::uint64_t> const& keys )
+{
+    if( !opts.selected( label ) ) return;
+
+    reset_counters();
+
+    {
+        auto map = container_traits<Map>::make();
+
+        std::size_t overall_peak = s_peak_bytes;
+
+        auto next_size = sizes.begin();
+
+        for( std::size_t i = 0; i < num_elements; ++i )
+        {
+            auto before = take_snapshot( map );
+
+            // peak during this insertion, which includes both bucket arrays
+            // when the insertion triggers a rehash
+
+            s_peak_bytes = s_live_bytes;
+            container_traits<Map>::insert( map, keys[ i ], i );
+
+            std::size_t op_peak = s_peak_bytes;
+
+            overall_peak = std::max( overall_peak, op_peak );
+            s_peak_bytes = overall_peak;
+
+            auto after = take_snapshot( map );
+
+            if( after.bucket_count != before.bucket_count && before.size != 0 )
+            {
+                record<Map>( rep, label, "size=" + std::to_string( before.size ) + " (before growth)", before, before.live_bytes );
+                record<Map>( rep, label, "size=" + std::to_string( after.size ) + " (after growth)", after, op_peak );
+            }
+
+            while( next_size != sizes.end() && *next_size <= after.size )
+            {
+                if( *next_size == after.size )
+                {
+                    record<Map>( rep, label, "size=" + std::to_string( after.size ), after, overall_peak );
+                }
+
+                ++next_size;
+            }
+        }
+
+        // churn: replace half of the elements, so that the effects of erasure
+        // (node deallocation, open-addressing rehashes caused by tombstones)
+        // are accounted for
+
+        for( std::size_t i = 0; i < num_elements / 2; ++i )
+        {
+            map.erase( keys[ i ] );
+            container_traits<Map>::insert( map, keys[ num_elements + i ], i );
+        }
+
+        record<Map>( rep, label, "size=" + std::to_string( map.size() ) + " (after churn)", take_snapshot( map ), s_peak_bytes );
+    }
+
+    // all memory should have been returned
+    if( s_live_bytes != 0 || s_live_alloc_count != 0 )
+    {
+        std::cerr << label << ": " << s_live_bytes << " bytes in " << s_live_alloc_count << " allocations not deallocated\n";
+    }
+}
+
+template<class K, class V> using allocator_for = ::allocator< std::pair<K const, V> >;
+
+template<class K, class V> using std_unordered_map =
+    std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_unordered_map =
+    boost::unordered_map<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_unordered_node_map =
+    boost::unordered_node_map<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_unordered_flat_map =
+    boost::unordered_flat_map<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_concurrent_flat_map =
+    boost::concurrent_flat_map<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_concurrent_node_map =
+    boost::concurrent_node_map<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_concurrent_flat_cache =
+    boost::concurrent_flat_cache<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K, class V> using boost_sharded_flat_map =
+    boost::unordered::sharded_flat_map<K, V, boost::hash<K>, std::equal_to<K>, allocator_for<K, V>>;
+
+template<class K> using std_unordered_set =
+    std::unordered_set<K, std::hash<K>, std::equal_to<K>, ::allocator<K>>;
+
+template<class K> using boost_unordered_set =
+    boost::unordered_set<K, boost::hash<K>, std::equal_to<K>, ::allocator<K>>;
+
+template<class K> using boost_unordered_node_set =
+    boost::unordered_node_set<K, boost::hash<K>, std::equal_to<K>, ::allocator<K>>;
+
+template<class K> using boost_unordered_flat_set =
+    boost::unordered_flat_set<K, boost::hash<K>, std::equal_to<K>, ::allocator<K>>;
+
+template<class K> using boost_concurrent_flat_set =
+    boost::concurrent_flat_set<K, boost::hash<K>, std::equal_to<K>, ::allocator<K>>;
+
+template<class K> using boost_concurrent_node_set =
+    boost::concurrent_node_set<K, boost::hash<K>, std::equal_to<K>, ::allocator<K>>;
+
+int main( int argc, char** argv )
+{
+    bench::command_line cl( argc, argv );
+
+    // measurements are deterministic, so --repetitions is not accepted
+    bench::common_options options( cl, 1'000'000, false );
+
+    std::string default_sizes;
+
+    for( std::size_t s = 1000; s < options.n; s *= 10 )
+    {
+        default_sizes += std::to_string( s ) + ",";
+    }
+
+    default_sizes += std::to_string( options.n );
+
+    std::string sizes_arg = cl.get( "sizes", default_sizes, "comma-separated list of sizes to report besides growth boundaries" );
+
+    for( auto const& x: bench::split( sizes_arg ) )
+    {
+        auto s = static_cast<std::size_t>( std::strtoull( x.c_str(), nullptr, 10 ) );
+
+        if( s == 0 || s > options.n ) cl.error( "invalid size " + x + " (must be between 1 and --n)" );
+        else sizes.push_back( s );
+    }
+
+    if( !cl.check() ) return 1;
+
+    std::sort( sizes.begin(), sizes.end() );
+
+    num_elements = options.n;
+
+    bench::reporter rep( "memory" );
+
+    options.describe( rep );
+    rep.param( "shards", num_shards );
+
+    // the second half of the keys is used for churn
+    auto keys = bench::make_keys( options.distribution, num_elements + num_elements / 2, options.seed );
+
+    using K = std::uint64_t;
+    using V = std::uint64_t;
+
+    test< std_unordered_map<K, V> >( options, rep, "std::unordered_map", keys );
+    test< boost_unordered_map<K, V> >( options, rep, "boost::unordered_map", keys );
+    test< boost_unordered_node_map<K, V> >( options, rep, "boost::unordered_node_map", keys );
+    test< boost_unordered_flat_map<K, V> >( options, rep, "boost::unordered_flat_map", keys );
+    test< boost_concurrent_flat_map<K, V> >( options, rep, "boost::concurrent_flat_map", keys );
+    test< boost_concurrent_node_map<K, V> >( options, rep, "boost::concurrent_node_map", keys );
+    test< boost_concurrent_flat_cache<K, V> >( options, rep, "boost::concurrent_flat_cache", keys );
+    test< boost_sharded_flat_map<K, V> >( options, rep, "boost::unordered::sharded_flat_map", keys );
+
+    test< std_unordered_set<K> >( options, rep, "std::unordered_set", keys );
+    test< boost_unordered_set<K> >( options, rep, "boost::unordered_set", keys );
+    test< boost_unordered_node_set<K> >( options, rep, "boost::unordered_node_set", keys );
+    test< boost_unordered_flat_set<K> >( options, rep, "boost::unordered_flat_set", keys );
+    test< boost_concurrent_flat_set<K> >( options, rep, "boost::concurrent_flat_set", keys );
+    test< boost_concurrent_node_set<K> >( options, rep, "boost::concurrent_node_set", keys );
+
+    return rep.write( options.format, options.output )? 0: 1;
+}
@@ -0,0 +1,145 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Insertion, lookup, iteration and erasure for the library containers and
+// std::unordered_map, with configurable size, key type and key distribution
+// and machine-readable output. Run with --help for the available options.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include "harness.hpp"
+#include <boost/unordered_map.hpp>
+#include <boost/unordered/unordered_node_map.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/config.hpp>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <string>
+
+static bench::common_options const* opts;
+
+template<class Key> static Key make_key( std::uint64_t x );
+
+template<> std::uint64_t make_key<std::uint64_t>( std::uint64_t x )
+{
+    return x;
+}
+
+template<> std::string make_key<std::string>( std::uint64_t x )
+{
+    return bench::make_string_key( x );
+}
+
+// The first half of the generated keys is inserted, the second half is used
+// for unsuccessful lookups.
+
+template<class Key> static void make_keys( std::vector<Key>& keys, std::vector<Key>& absent_keys )
+{
+    auto v = bench::make_keys( opts->distribution, opts->n * 2, opts->seed );
+
+    keys.clear();
+    absent_keys.clear();
+
+    for( std::size_t i = 0; i < opts->n; ++i )
+    {
+        keys.push_back( make_key<Key>( v[ i ] ) );
+        absent_keys.push_back( make_key<Key>( v[ opts->n + i ] ) );
+    }
+}
+
+template<class Map> BOOST_NOINLINE void test( bench::reporter& rep, char const* label )
+{
+    if( !opts->selected( label ) ) return;
+
+    using key_type = typename Map::key_type;
+
+    std::vector<key_type> keys, absent_keys;
+    make_keys( keys, absent_keys );
+
+    for( std::size_t r = 0; r < opts->repetitions; ++r )
+    {
+        Map map;
+        std::uint64_t s = 0;
+
+        auto t0 = bench::clock_type::now();
+
+        for( std::size_t i = 0; i < keys.size(); ++i )
+        {
+            map.insert( { keys[ i ], i } );
+        }
+
+        auto t1 = bench::clock_type::now();
+        rep.sample( label, "insert", keys.size(), bench::elapsed_ns( t0, t1 ) );
+
+        for( auto const& x: keys )
+        {
+            auto it = map.find( x );
+            if( it != map.end() ) s += it->second;
+        }
+
+        auto t2 = bench::clock_type::now();
+        rep.sample( label, "successful lookup", keys.size(), bench::elapsed_ns( t1, t2 ) );
+
+        for( auto const& x: absent_keys )
+        {
+            auto it = map.find( x );
+            if( it != map.end() ) s += it->second;
+        }
+
+        auto t3 = bench::clock_type::now();
+        rep.sample( label, "unsuccessful lookup", absent_keys.size(), bench::elapsed_ns( t2, t3 ) );
+
+        for( auto const& x: map )
+        {
+            s += x.second;
+        }
+
+        auto t4 = bench::clock_type::now();
+        rep.sample( label, "iteration", map.size(), bench::elapsed_ns( t3, t4 ) );
+
+        for( auto const& x: keys )
+        {
+            map.erase( x );
+        }
+
+        auto t5 = bench::clock_type::now();
+        rep.sample( label, "erase", keys.size(), bench::elapsed_ns( t4, t5 ) );
+
+        bench::consume( s + map.size() );
+    }
+}
+
+template<class Key> static void run( bench::reporter& rep )
+{
+    test< std::unordered_map<Key, std::size_t> >( rep, "std::unordered_map" );
+    test< boost::unordered_map<Key, std::size_t> >( rep, "boost::unordered_map" );
+    test< boost::unordered_node_map<Key, std::size_t> >( rep, "boost::unordered_node_map" );
+    test< boost::unordered_flat_map<Key, std::size_t> >( rep, "boost::unordered_flat_map" );
+}
+
+int main( int argc, char** argv )
+{
+    bench::command_line cl( argc, argv );
+
+    bench::common_options options( cl, 1'000'000 );
+    std::string key = cl.get( "key", "uint64", "key type: uint64 or string" );
+
+    if( key != "uint64" && key != "string" ) cl.error( "unknown key type " + key );
+
+    if( !cl.check() ) return 1;
+
+    opts = &options;
+
+    bench::reporter rep( "suite" );
+
+    options.describe( rep );
+    rep.param( "key", key );
+
+    if( key == "uint64" ) run<std::uint64_t>( rep );
+    else run<std::string>( rep );
+
+    return rep.write( options.format, options.output )? 0: 1;
+}
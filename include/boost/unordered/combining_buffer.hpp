@@ -0,0 +1,159 @@
+/* Pre-aggregation buffer for concurrent maps.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_COMBINING_BUFFER_HPP
+#define BOOST_UNORDERED_COMBINING_BUFFER_HPP
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/uncaught_exceptions.hpp>
+
+#include <iterator>
+#include <utility>
+
+namespace boost {
+  namespace unordered {
+
+    /* Absorbs repeated emplace_or_combine operations on the same keys
+     * locally before applying them to the underlying concurrent map in bulk,
+     * which relieves group contention for hot keys. Buffers are meant to be
+     * used by one thread only, typically one per worker thread.
+     *
+     * Updates that don't fit into a full fixed-capacity map are dropped and
+     * reported by flush(), which has to be called explicitly before
+     * destruction: the destructor discards whatever is left in the buffer.
+     */
+
+    template <class ConcurrentMap, class Combine> class combining_buffer
+    {
+    public:
+      using map_type = ConcurrentMap;
+      using key_type = typename map_type::key_type;
+      using mapped_type = typename map_type::mapped_type;
+      using value_type = typename map_type::value_type;
+      using hasher = typename map_type::hasher;
+      using key_equal = typename map_type::key_equal;
+      using allocator_type = typename map_type::allocator_type;
+      using combine_function = Combine;
+      using size_type = std::size_t;
+
+      static constexpr size_type default_capacity = 1024;
+
+      explicit combining_buffer(map_type& m, Combine c = Combine(),
+        size_type capacity = default_capacity)
+          : map_(m), c_(std::move(c)), capacity_(capacity ? capacity : 1),
+            buf_(0, m.hash_function(), m.key_eq(), m.get_allocator())
+      {
+        buf_.reserve(capacity_);
+      }
+
+      combining_buffer(combining_buffer const&) = delete;
+      combining_buffer& operator=(combining_buffer const&) = delete;
+
+      ~combining_buffer()
+      {
+        /* pending updates not flushed other than on stack unwinding */
+        BOOST_ASSERT(empty() || boost::core::uncaught_exceptions() > 0);
+      }
+
+      template <class M>
+      BOOST_FORCEINLINE void emplace_or_combine(key_type const& k, M&& obj)
+      {
+        emplace_or_combine_impl(k, std::forward<M>(obj));
+      }
+
+      template <class M>
+      BOOST_FORCEINLINE void emplace_or_combine(key_type&& k, M&& obj)
+      {
+        emplace_or_combine_impl(std::move(k), std::forward<M>(obj));
+      }
+
+      /* Returns the number of entries dropped since the last call, including
+       * those dropped by automatic flushes in emplace_or_combine.
+       */
+
+      size_type flush()
+      {
+        size_type res = dropped_;
+        dropped_ = 0;
+        return res + flush_impl();
+      }
+
+      size_type size() const noexcept { return buf_.size(); }
+      size_type capacity() const noexcept { return capacity_; }
+      BOOST_ATTRIBUTE_NODISCARD bool empty() const noexcept
+      {
+        return size() == 0;
+      }
+
+    private:
+      using buffer_type = boost::unordered_flat_map<key_type, mapped_type,
+        hasher, key_equal, allocator_type>;
+
+      struct clear_on_exit
+      {
+        ~clear_on_exit() { buf.clear(); }
+
+        buffer_type& buf;
+      };
+
+      struct counting_combine
+      {
+        template <class M, class V>
+        mapped_type operator()(M&& x, V&& y) const
+        {
+          ++combined;
+          return c(std::forward<M>(x), std::forward<V>(y));
+        }
+
+        Combine& c;
+        size_type& combined;
+      };
+
+      /* entries neither inserted nor combined are those the map, at fixed
+       * capacity, had no room for
+       */
+
+      size_type flush_impl()
+      {
+        clear_on_exit c{buf_};
+        size_type n = buf_.size(), combined = 0;
+        size_type inserted =
+          map_.insert_or_combine(std::make_move_iterator(buf_.begin()),
+            std::make_move_iterator(buf_.end()),
+            counting_combine{c_, combined});
+        return n - inserted - combined;
+      }
+
+      template <class K, class M>
+      BOOST_FORCEINLINE void emplace_or_combine_impl(K&& k, M&& obj)
+      {
+        auto it = buf_.find(k);
+        if (it != buf_.end()) {
+          it->second = c_(std::move(it->second), std::forward<M>(obj));
+          return;
+        }
+        if (buf_.size() >= capacity_) dropped_ += flush_impl();
+        buf_.try_emplace(std::forward<K>(k), std::forward<M>(obj));
+      }
+
+      map_type& map_;
+      Combine c_;
+      size_type capacity_;
+      size_type dropped_ = 0;
+      buffer_type buf_;
+    };
+  } // namespace unordered
+
+  using boost::unordered::combining_buffer;
+} // namespace boost
+
+#endif // BOOST_UNORDERED_COMBINING_BUFFER_HPP
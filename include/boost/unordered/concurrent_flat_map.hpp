@@ -60,6 +60,17 @@ namespace boost {
         Archive& ar, concurrent_flat_map<K, V, H, KE, A>& c,
         unsigned int version);
 
+      template <class F> struct combine_visitor
+      {
+        template <class Value, class V>
+        void operator()(Value& x, V&& v) const
+        {
+          x.second = f(std::move(x.second), std::forward<V>(v).second);
+        }
+
+        F& f;
+      };
+
     public:
       using key_type = Key;
       using mapped_type = T;
@@ -76,6 +87,9 @@ namespace boost {
       using const_pointer =
         typename boost::allocator_const_pointer<allocator_type>::type;
       static constexpr size_type bulk_visit_size = table_type::bulk_visit_size;
+      using unsynchronized_view = typename table_type::unsynchronized_view;
+
+      using layout_stats_type = typename table_type::layout_stats_type;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       using stats = typename table_type::stats;
@@ -93,6 +107,13 @@ namespace boost {
       {
       }
 
+      concurrent_flat_map(fixed_capacity_t, size_type n,
+        const hasher& hf = hasher(), const key_equal& eql = key_equal(),
+        const allocator_type& a = allocator_type())
+          : table_(fixed_capacity_t{}, n, hf, eql, a)
+      {
+      }
+
       template <class InputIterator>
       concurrent_flat_map(InputIterator f, InputIterator l,
         size_type n = detail::foa::default_bucket_count,
@@ -330,6 +351,60 @@ namespace boost {
         return table_.visit(std::forward<K>(k), f);
       }
 
+      template <class F>
+      BOOST_FORCEINLINE nonblocking_result visit(
+        nonblocking_t, key_type const& k, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit(nonblocking_t{}, k, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE nonblocking_result visit(
+        nonblocking_t, key_type const& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(nonblocking_t{}, k, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE nonblocking_result cvisit(
+        nonblocking_t, key_type const& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(nonblocking_t{}, k, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        nonblocking_result>::type
+      visit(nonblocking_t, K&& k, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit(nonblocking_t{}, std::forward<K>(k), f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        nonblocking_result>::type
+      visit(nonblocking_t, K&& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(nonblocking_t{}, std::forward<K>(k), f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        nonblocking_result>::type
+      cvisit(nonblocking_t, K&& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(nonblocking_t{}, std::forward<K>(k), f);
+      }
+
       template<class FwdIterator, class F>
       BOOST_FORCEINLINE
       size_t visit(FwdIterator first, FwdIterator last, F f)
@@ -375,6 +450,12 @@ namespace boost {
         return table_.cvisit_all(f);
       }
 
+      template <class F> size_type cvisit_all(snapshot_t, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.cvisit_all(snapshot_t{}, f);
+      }
+
 #if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
       template <class ExecPolicy, class F>
       typename std::enable_if<detail::is_execution_policy<ExecPolicy>::value,
@@ -407,6 +488,42 @@ namespace boost {
       }
 #endif
 
+      template <class F> void visit_all(work_stealing_executor& ex, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        table_.visit_all(ex, f);
+      }
+
+      template <class F> void visit_all(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        table_.visit_all(ex, f);
+      }
+
+      template <class F> void cvisit_all(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        table_.cvisit_all(ex, f);
+      }
+
+      template <class R, class BinaryOp, class F>
+      R transform_reduce(R init, BinaryOp reduce, F transform) const
+      {
+        return table_.transform_reduce(std::move(init), reduce, transform);
+      }
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+      template <class ExecPolicy, class R, class BinaryOp, class F>
+      typename std::enable_if<detail::is_execution_policy<ExecPolicy>::value,
+        R>::type
+      transform_reduce(
+        ExecPolicy&& p, R init, BinaryOp reduce, F transform) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_EXEC_POLICY(ExecPolicy)
+        return table_.transform_reduce(p, std::move(init), reduce, transform);
+      }
+#endif
+
       template <class F> bool visit_while(F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
@@ -457,6 +574,25 @@ namespace boost {
       }
 #endif
 
+      template <class F> bool visit_while(work_stealing_executor& ex, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit_while(ex, f);
+      }
+
+      template <class F> bool visit_while(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit_while(ex, f);
+      }
+
+      template <class F>
+      bool cvisit_while(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.cvisit_while(ex, f);
+      }
+
       /// Modifiers
       ///
 
@@ -475,11 +611,7 @@ namespace boost {
       template <class InputIterator>
       size_type insert(InputIterator begin, InputIterator end)
       {
-        size_type count_elements = 0;
-        for (auto pos = begin; pos != end; ++pos) {
-          if (table_.emplace(*pos)) ++count_elements;
-        }
-        return count_elements;
+        return table_.insert(begin, end);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -525,6 +657,43 @@ namespace boost {
           [&](value_type& m) { m.second = std::forward<M>(obj); });
       }
 
+      template <class M, class F>
+      BOOST_FORCEINLINE bool emplace_or_combine(
+        key_type const& k, M&& obj, F f)
+      {
+        return table_.try_emplace_or_visit(k, std::forward<M>(obj),
+          [&](value_type& m) {
+            m.second = f(std::move(m.second), std::forward<M>(obj));
+          });
+      }
+
+      template <class M, class F>
+      BOOST_FORCEINLINE bool emplace_or_combine(key_type&& k, M&& obj, F f)
+      {
+        return table_.try_emplace_or_visit(std::move(k), std::forward<M>(obj),
+          [&](value_type& m) {
+            m.second = f(std::move(m.second), std::forward<M>(obj));
+          });
+      }
+
+      template <class K, class M, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, bool>::type
+      emplace_or_combine(K&& k, M&& obj, F f)
+      {
+        return table_.try_emplace_or_visit(std::forward<K>(k),
+          std::forward<M>(obj), [&](value_type& m) {
+            m.second = f(std::move(m.second), std::forward<M>(obj));
+          });
+      }
+
+      template <class InputIterator, class F>
+      size_type insert_or_combine(
+        InputIterator first, InputIterator last, F f)
+      {
+        return table_.insert_or_combine(first, last, combine_visitor<F>{f});
+      }
+
       template <class Ty, class F>
       BOOST_FORCEINLINE auto insert_or_visit(Ty&& value, F f)
         -> decltype(table_.insert_or_visit(std::forward<Ty>(value), f))
@@ -540,15 +709,29 @@ namespace boost {
         return table_.insert_or_visit(std::move(obj), f);
       }
 
+      template <class Ty, class F>
+      BOOST_FORCEINLINE auto insert_or_visit(nonblocking_t, Ty&& value, F f)
+        -> decltype(table_.insert_or_visit(
+          nonblocking_t{}, std::forward<Ty>(value), f))
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.insert_or_visit(
+          nonblocking_t{}, std::forward<Ty>(value), f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE nonblocking_result insert_or_visit(
+        nonblocking_t, init_type&& obj, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.insert_or_visit(nonblocking_t{}, std::move(obj), f);
+      }
+
       template <class InputIterator, class F>
       size_type insert_or_visit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_visit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_visit(first, last, f);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -588,15 +771,29 @@ namespace boost {
         return table_.insert_or_cvisit(std::move(obj), f);
       }
 
+      template <class Ty, class F>
+      BOOST_FORCEINLINE auto insert_or_cvisit(nonblocking_t, Ty&& value, F f)
+        -> decltype(table_.insert_or_cvisit(
+          nonblocking_t{}, std::forward<Ty>(value), f))
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.insert_or_cvisit(
+          nonblocking_t{}, std::forward<Ty>(value), f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE nonblocking_result insert_or_cvisit(
+        nonblocking_t, init_type&& obj, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.insert_or_cvisit(nonblocking_t{}, std::move(obj), f);
+      }
+
       template <class InputIterator, class F>
       size_type insert_or_cvisit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_cvisit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_cvisit(first, last, f);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -644,11 +841,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_visit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_visit(first, last, f1, f2);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -702,11 +895,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_cvisit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_cvisit(first, last, f1, f2);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -758,6 +947,24 @@ namespace boost {
           std::forward<Arg>(arg), std::forward<Args>(args)...);
       }
 
+      template <class Arg, class... Args>
+      BOOST_FORCEINLINE nonblocking_result emplace_or_visit(
+        nonblocking_t, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_INVOCABLE(Arg, Args...)
+        return table_.emplace_or_visit(nonblocking_t{},
+          std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
+      template <class Arg, class... Args>
+      BOOST_FORCEINLINE nonblocking_result emplace_or_cvisit(
+        nonblocking_t, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_CONST_INVOCABLE(Arg, Args...)
+        return table_.emplace_or_cvisit(nonblocking_t{},
+          std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
       template <class Arg1, class Arg2, class... Args>
       BOOST_FORCEINLINE bool emplace_and_visit(
          Arg1&& arg1, Arg2&& arg2, Args&&... args)
@@ -942,6 +1149,28 @@ namespace boost {
         return table_.erase(std::forward<K>(k));
       }
 
+      BOOST_FORCEINLINE nonblocking_result erase(
+        nonblocking_t, key_type const& k)
+      {
+        return table_.erase(nonblocking_t{}, k);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        nonblocking_result>::type
+      erase(nonblocking_t, K&& k)
+      {
+        return table_.erase(nonblocking_t{}, std::forward<K>(k));
+      }
+
+      template <class FwdIterator>
+      BOOST_FORCEINLINE size_type erase(FwdIterator first, FwdIterator last)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.erase(first, last);
+      }
+
       template <class F>
       BOOST_FORCEINLINE size_type erase_if(key_type const& k, F f)
       {
@@ -969,6 +1198,11 @@ namespace boost {
       }
 #endif
 
+      template <class F> void erase_if(work_stealing_executor& ex, F f)
+      {
+        table_.erase_if(ex, f);
+      }
+
       template <class F> size_type erase_if(F f) { return table_.erase_if(f); }
 
       void swap(concurrent_flat_map& other) noexcept(
@@ -1034,6 +1268,27 @@ namespace boost {
       void rehash(size_type n) { table_.rehash(n); }
       void reserve(size_type n) { table_.reserve(n); }
 
+      memory_usage_info memory_usage() const noexcept
+      {
+        return table_.memory_usage();
+      }
+
+      layout_stats_type layout_stats() const { return table_.layout_stats(); }
+
+      float preallocation_threshold() const noexcept
+      {
+        return table_.preallocation_threshold();
+      }
+      void preallocation_threshold(float t)
+      {
+        table_.preallocation_threshold(t);
+      }
+
+      bool has_fixed_capacity() const noexcept
+      {
+        return table_.has_fixed_capacity();
+      }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       /// Stats
       ///
@@ -1042,6 +1297,15 @@ namespace boost {
       void reset_stats() noexcept { table_.reset_stats(); }
 #endif
 
+      /// Exclusive Access
+      ///
+      template <class F>
+      auto with_exclusive(F f)
+        -> decltype(f(std::declval<unsynchronized_view&>()))
+      {
+        return table_.with_exclusive(f);
+      }
+
       /// Observers
       ///
       allocator_type get_allocator() const noexcept
@@ -73,6 +73,9 @@ namespace boost {
       using const_pointer =
         typename boost::allocator_const_pointer<allocator_type>::type;
       static constexpr size_type bulk_visit_size = table_type::bulk_visit_size;
+      using unsynchronized_view = typename table_type::unsynchronized_view;
+
+      using layout_stats_type = typename table_type::layout_stats_type;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       using stats = typename table_type::stats;
@@ -406,6 +409,42 @@ namespace boost {
       }
 #endif
 
+      template <class F> void visit_all(work_stealing_executor& ex, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        table_.visit_all(ex, f);
+      }
+
+      template <class F> void visit_all(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        table_.visit_all(ex, f);
+      }
+
+      template <class F> void cvisit_all(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        table_.cvisit_all(ex, f);
+      }
+
+      template <class R, class BinaryOp, class F>
+      R transform_reduce(R init, BinaryOp reduce, F transform) const
+      {
+        return table_.transform_reduce(std::move(init), reduce, transform);
+      }
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+      template <class ExecPolicy, class R, class BinaryOp, class F>
+      typename std::enable_if<detail::is_execution_policy<ExecPolicy>::value,
+        R>::type
+      transform_reduce(
+        ExecPolicy&& p, R init, BinaryOp reduce, F transform) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_EXEC_POLICY(ExecPolicy)
+        return table_.transform_reduce(p, std::move(init), reduce, transform);
+      }
+#endif
+
       template <class F> bool visit_while(F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
@@ -456,6 +495,25 @@ namespace boost {
       }
 #endif
 
+      template <class F> bool visit_while(work_stealing_executor& ex, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit_while(ex, f);
+      }
+
+      template <class F> bool visit_while(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit_while(ex, f);
+      }
+
+      template <class F>
+      bool cvisit_while(work_stealing_executor& ex, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.cvisit_while(ex, f);
+      }
+
       /// Modifiers
       ///
 
@@ -481,11 +539,7 @@ namespace boost {
       template <class InputIterator>
       size_type insert(InputIterator begin, InputIterator end)
       {
-        size_type count_elements = 0;
-        for (auto pos = begin; pos != end; ++pos) {
-          if (table_.emplace(*pos)) ++count_elements;
-        }
-        return count_elements;
+        return table_.insert(begin, end);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -535,11 +589,7 @@ namespace boost {
       size_type insert_or_visit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_visit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_visit(first, last, f);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -592,11 +642,7 @@ namespace boost {
       size_type insert_or_cvisit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_cvisit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_cvisit(first, last, f);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -655,11 +701,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_visit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_visit(first, last, f1, f2);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -723,11 +765,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_cvisit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_cvisit(first, last, f1, f2);
       }
 
 #if !defined(BOOST_UNORDERED_NO_RANGES)
@@ -816,6 +854,13 @@ namespace boost {
         return table_.erase(std::forward<K>(k));
       }
 
+      template <class FwdIterator>
+      BOOST_FORCEINLINE size_type erase(FwdIterator first, FwdIterator last)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.erase(first, last);
+      }
+
       template <class F>
       BOOST_FORCEINLINE size_type erase_if(key_type const& k, F f)
       {
@@ -843,6 +888,11 @@ namespace boost {
       }
 #endif
 
+      template <class F> void erase_if(work_stealing_executor& ex, F f)
+      {
+        table_.erase_if(ex, f);
+      }
+
       template <class F> size_type erase_if(F f) { return table_.erase_if(f); }
 
       void swap(concurrent_flat_set& other) noexcept(
@@ -908,6 +958,22 @@ namespace boost {
       void rehash(size_type n) { table_.rehash(n); }
       void reserve(size_type n) { table_.reserve(n); }
 
+      memory_usage_info memory_usage() const noexcept
+      {
+        return table_.memory_usage();
+      }
+
+      layout_stats_type layout_stats() const { return table_.layout_stats(); }
+
+      float preallocation_threshold() const noexcept
+      {
+        return table_.preallocation_threshold();
+      }
+      void preallocation_threshold(float t)
+      {
+        table_.preallocation_threshold(t);
+      }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       /// Stats
       ///
@@ -916,6 +982,15 @@ namespace boost {
       void reset_stats() noexcept { table_.reset_stats(); }
 #endif
 
+      /// Exclusive Access
+      ///
+      template <class F>
+      auto with_exclusive(F f)
+        -> decltype(f(std::declval<unsynchronized_view&>()))
+      {
+        return table_.with_exclusive(f);
+      }
+
       /// Observers
       ///
       allocator_type get_allocator() const noexcept
@@ -116,6 +116,7 @@ to normal separate chaining implementations.
 #include <boost/unordered/detail/prime_fmod.hpp>
 #include <boost/unordered/detail/serialize_tracked_address.hpp>
 #include <boost/unordered/detail/opt_storage.hpp>
+#include <boost/unordered/memory_usage.hpp>
 
 #include <boost/assert.hpp>
 #include <boost/core/allocator_access.hpp>
@@ -717,6 +718,22 @@ namespace boost {
 
         size_type groups_len() const noexcept { return size_ / group::N + 1; }
 
+        size_type allocated_bytes() const noexcept
+        {
+          return size_ ? buckets_len() * sizeof(bucket_type) +
+                           groups_len() * sizeof(group)
+                       : 0;
+        }
+
+        void add_memory_usage(
+          boost::unordered::memory_usage_info& res) const noexcept
+        {
+          if (size_) {
+            res.buckets += buckets_len() * sizeof(bucket_type);
+            res.group_metadata += groups_len() * sizeof(group);
+          }
+        }
+
         void reset_allocator(Allocator const& allocator_)
         {
           this->get_node_allocator() = node_allocator_type(allocator_);
@@ -0,0 +1,353 @@
+/* Fast open-addressing concurrent hash table with CLOCK eviction.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_FOA_CONCURRENT_CLOCK_TABLE_HPP
+#define BOOST_UNORDERED_DETAIL_FOA_CONCURRENT_CLOCK_TABLE_HPP
+
+#include <atomic>
+#include <boost/config.hpp>
+#include <boost/core/allocator_access.hpp>
+#include <boost/core/pointer_traits.hpp>
+#include <boost/unordered/detail/foa/concurrent_table.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace unordered{
+namespace detail{
+namespace foa{
+
+/* concurrent_clock_table is a concurrent_table in fixed-capacity mode
+ * that keeps its size bounded by a user-provided capacity through CLOCK
+ * (second-chance) eviction:
+ *
+ *   - Each slot has an associated reference byte, stored in a side array
+ *     allocated once at construction time (the bucket array of a
+ *     fixed-capacity table never changes, so slot positions are stable).
+ *   - Lookup with visitation sets the reference byte of the element found.
+ *     The byte is read before writing so that repeated hits on the same
+ *     element don't keep bouncing its cache line among readers.
+ *   - Insertion sets the reference byte of the new element and, if size
+ *     then exceeds capacity, evicts one element. If the underlying table is
+ *     full, an element is evicted before trying again.
+ *   - Eviction advances a shared atomic hand over the groups of the table
+ *     (with container-level shared access, as any other operation).
+ *     Under the group's exclusive lock, occupied slots with their reference
+ *     byte set are given a second chance (the byte is cleared), and the
+ *     first one found unreferenced is passed to the eviction handler and
+ *     erased. Two full turns of the hand are enough to find a victim in
+ *     the absence of concurrent references.
+ *
+ * As the hand moves at group granularity, the policy is an approximation of
+ * textbook CLOCK trading some accuracy for less contention on the hand.
+ * Transiently, size() may exceed capacity by up to the number of threads
+ * concurrently inserting. Only flat maps (element_type==value_type) are
+ * supported, since reference bytes are located from element addresses.
+ */
+
+template<typename TypePolicy,typename Hash,typename Pred,typename Allocator>
+class concurrent_clock_table:
+  public concurrent_table<TypePolicy,Hash,Pred,Allocator>
+{
+  using super=concurrent_table<TypePolicy,Hash,Pred,Allocator>;
+  using type_policy=typename super::type_policy;
+  using group_type=typename super::group_type;
+  using super::N;
+  using group_shared=typename super::group_shared;
+  using group_exclusive=typename super::group_exclusive;
+  using erase_on_exit=typename super::erase_on_exit;
+  template<typename Value,typename T>
+  using enable_if_is_value_type=
+    typename super::template enable_if_is_value_type<Value,T>;
+
+  using ref_type=std::atomic<unsigned char>;
+  using ref_allocator_type=
+    typename boost::allocator_rebind<Allocator,ref_type>::type;
+  using ref_pointer=
+    typename boost::allocator_pointer<ref_allocator_type>::type;
+
+public:
+  using key_type=typename super::key_type;
+  using init_type=typename super::init_type;
+  using value_type=typename super::value_type;
+  using element_type=typename super::element_type;
+  using eviction_handler=std::function<void(value_type&)>;
+
+  static_assert(
+    std::is_same<element_type,value_type>::value,
+    "concurrent_clock_table requires flat elements");
+
+  concurrent_clock_table(
+    std::size_t capacity_,eviction_handler on_evict_=eviction_handler(),
+    const Hash& h_=Hash(),const Pred& pred_=Pred(),
+    const Allocator& al_=Allocator()):
+    super{fixed_capacity_t{},capacity_,h_,pred_,al_},
+    cap{capacity_},on_evict{std::move(on_evict_)},
+    num_refs{
+      this->arrays.elements()?(this->arrays.groups_size_mask+1)*N:0}
+  {
+    if(num_refs){
+      ref_allocator_type ral(this->al());
+      refs_=boost::allocator_allocate(ral,num_refs);
+      for(std::size_t i=0;i<num_refs;++i)::new (refs()+i) ref_type(0);
+    }
+  }
+
+  concurrent_clock_table(const concurrent_clock_table&)=delete;
+  concurrent_clock_table& operator=(const concurrent_clock_table&)=delete;
+
+  ~concurrent_clock_table()
+  {
+    if(num_refs){
+      ref_allocator_type ral(this->al());
+      boost::allocator_deallocate(ral,refs_,num_refs);
+    }
+  }
+
+  std::size_t capacity()const noexcept{return cap;}
+
+  /* reference bytes are counted as group metadata */
+
+  memory_usage_info memory_usage()const noexcept
+  {
+    auto res=super::memory_usage();
+    res.group_metadata+=num_refs*sizeof(ref_type);
+    res.total+=num_refs*sizeof(ref_type);
+    return res;
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit(const Key& x,F&& f)
+  {
+    return this->visit_impl(
+      group_exclusive{},x,referencing_visitor<F>{this,f,nullptr});
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit(const Key& x,F&& f)const
+  {
+    return this->visit_impl(
+      group_shared{},x,referencing_visitor<F>{this,f,nullptr});
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t cvisit(const Key& x,F&& f)const
+  {
+    return visit(x,std::forward<F>(f));
+  }
+
+  template<typename... Args>
+  BOOST_FORCEINLINE bool emplace(Args&&... args)
+  {
+    alloc_cted_insert_type<type_policy,Allocator,Args...> x(
+      this->al(),std::forward<Args>(args)...);
+    return emplace_or_visit_and_evict(
+      group_shared{},[](const value_type&){},type_policy::move(x.value()));
+  }
+
+  BOOST_FORCEINLINE bool insert(const init_type& x)
+  {
+    return emplace_or_visit_and_evict(
+      group_shared{},[](const value_type&){},x);
+  }
+
+  BOOST_FORCEINLINE bool insert(init_type&& x)
+  {
+    return emplace_or_visit_and_evict(
+      group_shared{},[](const value_type&){},std::move(x));
+  }
+
+  /* template<typename=void> tilts call ambiguities in favor of init_type */
+
+  template<typename=void>
+  BOOST_FORCEINLINE bool insert(const value_type& x)
+  {
+    return emplace_or_visit_and_evict(
+      group_shared{},[](const value_type&){},x);
+  }
+
+  template<typename=void>
+  BOOST_FORCEINLINE bool insert(value_type&& x)
+  {
+    return emplace_or_visit_and_evict(
+      group_shared{},[](const value_type&){},std::move(x));
+  }
+
+  template<typename Key,typename... Args>
+  BOOST_FORCEINLINE bool try_emplace(Key&& x,Args&&... args)
+  {
+    return emplace_or_visit_and_evict(
+      group_shared{},[](const value_type&){},
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+  }
+
+  template<typename Key,typename M>
+  BOOST_FORCEINLINE bool insert_or_assign(Key&& x,M&& obj)
+  {
+    return emplace_or_visit_and_evict(
+      group_exclusive{},
+      [&](value_type& m){m.second=std::forward<M>(obj);},
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<M>(obj));
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_visit(const init_type& x,F&& f)
+  {
+    return emplace_or_visit_and_evict(group_exclusive{},f,x);
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_cvisit(const init_type& x,F&& f)
+  {
+    return emplace_or_visit_and_evict(group_shared{},f,x);
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_visit(init_type&& x,F&& f)
+  {
+    return emplace_or_visit_and_evict(group_exclusive{},f,std::move(x));
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_cvisit(init_type&& x,F&& f)
+  {
+    return emplace_or_visit_and_evict(group_shared{},f,std::move(x));
+  }
+
+  /* SFINAE tilts call ambiguities in favor of init_type */
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_visit(const Value& x,F&& f)
+    ->enable_if_is_value_type<Value,bool>
+  {
+    return emplace_or_visit_and_evict(group_exclusive{},f,x);
+  }
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_cvisit(const Value& x,F&& f)
+    ->enable_if_is_value_type<Value,bool>
+  {
+    return emplace_or_visit_and_evict(group_shared{},f,x);
+  }
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_visit(Value&& x,F&& f)
+    ->enable_if_is_value_type<Value,bool>
+  {
+    return emplace_or_visit_and_evict(group_exclusive{},f,std::move(x));
+  }
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_cvisit(Value&& x,F&& f)
+    ->enable_if_is_value_type<Value,bool>
+  {
+    return emplace_or_visit_and_evict(group_shared{},f,std::move(x));
+  }
+
+  /* Evicts one element if the table is not empty. Container-level shared
+   * access keeps eviction from racing with clear() and other operations
+   * taking exclusive access to the whole table.
+   */
+
+  bool evict()
+  {
+    if(!num_refs)return false;
+
+    auto lck=this->shared_access();
+    auto groups_size_mask=this->arrays.groups_size_mask;
+    auto pg0=this->arrays.groups();
+    auto last=pg0+groups_size_mask+1;
+    for(std::size_t i=0,m=2*(groups_size_mask+1);i<m;++i){
+      auto pos=hand.fetch_add(1,std::memory_order_relaxed)&groups_size_mask;
+      auto pg=pg0+pos;
+      auto lck=this->access(group_exclusive{},pos);
+      auto mask=this->match_really_occupied(pg,last);
+      while(mask){
+        auto n=unchecked_countr_zero(mask);
+        auto& r=refs()[pos*N+n];
+        if(r.load(std::memory_order_relaxed)){
+          r.store(0,std::memory_order_relaxed);
+        }
+        else{
+          auto         p=this->arrays.elements()+pos*N+n;
+          erase_on_exit e{*this,pg,n,p}; /* erase even if on_evict throws */
+          if(on_evict){
+            on_evict(super::cast_for(
+              group_exclusive{},type_policy::value_from(*p)));
+          }
+          return true;
+        }
+        mask&=mask-1;
+      }
+    }
+    return false;
+  }
+
+private:
+  ref_type* refs()const noexcept{return boost::to_address(refs_);}
+
+  BOOST_FORCEINLINE void reference(const value_type& x)const noexcept
+  {
+    auto& r=refs()[std::addressof(x)-this->arrays.elements()];
+    if(!r.load(std::memory_order_relaxed))r.store(1,std::memory_order_relaxed);
+  }
+
+  template<typename F>
+  struct referencing_visitor
+  {
+    template<typename Value>
+    BOOST_FORCEINLINE void operator()(Value& x)const
+    {
+      if(found)*found=true;
+      this_->reference(x);
+      f(x);
+    }
+
+    const concurrent_clock_table *this_;
+    F                            &f;
+    bool                         *found;
+  };
+
+  template<typename GroupAccessMode,typename F,typename... Args>
+  BOOST_FORCEINLINE bool emplace_or_visit_and_evict(
+    GroupAccessMode access_mode,F&& f,Args&&... args)
+  {
+    for(;;){
+      bool found=false;
+      if(this->emplace_and_visit_impl(
+        access_mode,
+        [this](const value_type& x){reference(x);},
+        referencing_visitor<F>{this,f,&found},
+        std::forward<Args>(args)...)){
+        if(this->size()>cap)evict();
+        return true;
+      }
+      /* table full unless found, make room and retry */
+      if(found||!evict())return false;
+    }
+  }
+
+  std::size_t               cap;
+  eviction_handler          on_evict;
+  std::size_t               num_refs;
+  ref_pointer               refs_=ref_pointer();
+  std::atomic<std::size_t>  hand{0};
+};
+
+} /* namespace foa */
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
@@ -18,19 +18,24 @@
 #include <boost/core/ignore_unused.hpp>
 #include <boost/core/no_exceptions_support.hpp>
 #include <boost/core/serialization.hpp>
+#include <boost/core/yield_primitives.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/mp11/tuple.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/unordered/detail/archive_constructed.hpp>
 #include <boost/unordered/detail/bad_archive_exception.hpp>
 #include <boost/unordered/detail/foa/core.hpp>
+#include <boost/unordered/detail/foa/quiescence.hpp>
 #include <boost/unordered/detail/foa/reentrancy_check.hpp>
 #include <boost/unordered/detail/foa/rw_spinlock.hpp>
+#include <boost/unordered/detail/foa/table.hpp>
 #include <boost/unordered/detail/foa/tuple_rotate_right.hpp>
+#include <boost/unordered/detail/parallel_algorithms.hpp>
 #include <boost/unordered/detail/serialization_version.hpp>
 #include <boost/unordered/detail/static_assert.hpp>
 #include <boost/unordered/detail/type_traits.hpp>
 #include <cstddef>
+#include <exception>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -40,38 +45,38 @@
 #include <tuple>
 #include <utility>
 
-#if !defined(BOOST_UNORDERED_DISABLE_PARALLEL_ALGORITHMS)
-#if defined(BOOST_UNORDERED_ENABLE_PARALLEL_ALGORITHMS)|| \
-    !defined(BOOST_NO_CXX17_HDR_EXECUTION)
-#define BOOST_UNORDERED_PARALLEL_ALGORITHMS
-#endif
-#endif
-
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
-#include <algorithm>
-#include <execution>
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+#include <chrono>
 #endif
 
 namespace boost{
 namespace unordered{
-namespace detail{
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+/* Tag for construction of concurrent containers in fixed-capacity mode */
 
-template<typename ExecutionPolicy>
-using is_execution_policy=std::is_execution_policy<
-  typename std::remove_cv<
-    typename std::remove_reference<ExecutionPolicy>::type
-  >::type
->;
+struct fixed_capacity_t{explicit fixed_capacity_t()=default;};
+BOOST_INLINE_CONSTEXPR fixed_capacity_t fixed_capacity{};
 
-#else
+/* Tag for construction of node-based concurrent containers with epoch-based
+ * reclamation of erased elements.
+ */
 
-template<typename ExecutionPolicy>
-using is_execution_policy=std::false_type;
+struct epoch_reclamation_t{explicit epoch_reclamation_t()=default;};
+BOOST_INLINE_CONSTEXPR epoch_reclamation_t epoch_reclamation{};
 
-#endif
+/* Tag for point-in-time visitation of concurrent containers */
+
+struct snapshot_t{explicit snapshot_t()=default;};
+BOOST_INLINE_CONSTEXPR snapshot_t snapshot{};
 
+/* Tag for non-blocking operations of concurrent containers and their result */
+
+struct nonblocking_t{explicit nonblocking_t()=default;};
+BOOST_INLINE_CONSTEXPR nonblocking_t nonblocking{};
+
+enum class nonblocking_result{not_found,found,inserted,would_block,full};
+
+namespace detail{
 namespace foa{
 
 static constexpr std::size_t cacheline_size=64;
@@ -117,6 +122,13 @@ public:
   }
 
   void lock()noexcept{for(std::size_t n=0;n<N;)mutexes[n++].lock();}
+
+  template<typename LockStats>
+  void lock(LockStats& stats)noexcept
+  {
+    for(std::size_t n=0;n<N;)mutexes[n++].lock(stats);
+  }
+
   void unlock()noexcept{for(auto n=N;n>0;)mutexes[--n].unlock();}
 
 private:
@@ -125,11 +137,17 @@ private:
 
 /* std::shared_lock is C++14 */
 
+struct adopt_shared_lock_t{};
+
 template<typename Mutex>
 class shared_lock
 {
 public:
-  shared_lock(Mutex& m_)noexcept:m(m_){m.lock_shared();}
+  shared_lock(Mutex& m_,bool lock_=true)noexcept:m(m_),owns(lock_)
+  {
+    if(owns)m.lock_shared();
+  }
+  shared_lock(Mutex& m_,adopt_shared_lock_t)noexcept:m(m_),owns(true){}
   ~shared_lock()noexcept{if(owns)m.unlock_shared();}
 
   /* not used but VS in pre-C++17 mode needs to see it for RVO */
@@ -140,7 +158,7 @@ public:
 
 private:
   Mutex &m;
-  bool owns=true;
+  bool  owns;
 };
 
 /* VS in pre-C++17 mode can't implement RVO for std::lock_guard due to
@@ -152,6 +170,9 @@ class lock_guard
 {
 public:
   lock_guard(Mutex& m_)noexcept:m(m_){m.lock();}
+
+  template<typename LockStats>
+  lock_guard(Mutex& m_,LockStats&& stats)noexcept:m(m_){m.lock(stats);}
   ~lock_guard()noexcept{m.unlock();}
 
   /* not used but VS in pre-C++17 mode needs to see it for RVO */
@@ -161,6 +182,96 @@ private:
   Mutex &m;
 };
 
+/* Non-blocking counterparts of shared_lock and lock_guard: success must be
+ * checked with owns_lock(). Acquisition is attempted a bounded number of
+ * times, as rw_spinlock::try_lock[_shared] can fail on a mere race with
+ * concurrent readers.
+ */
+
+static constexpr int try_lock_attempts=4;
+
+template<typename Mutex>
+class try_shared_lock
+{
+public:
+  try_shared_lock(Mutex& m_)noexcept:m(m_),owns(false)
+  {
+    for(int n=0;n<try_lock_attempts&&!owns;++n){
+      owns=m.try_lock_shared();
+    }
+  }
+  ~try_shared_lock()noexcept{if(owns)m.unlock_shared();}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  try_shared_lock(const try_shared_lock&);
+
+  bool owns_lock()const noexcept{return owns;}
+
+private:
+  Mutex &m;
+  bool  owns;
+};
+
+template<typename Mutex>
+class try_lock_guard
+{
+public:
+  try_lock_guard(Mutex& m_)noexcept:m(m_),owns(false)
+  {
+    for(int n=0;n<try_lock_attempts&&!owns;++n)owns=m.try_lock();
+  }
+  ~try_lock_guard()noexcept{if(owns)m.unlock();}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  try_lock_guard(const try_lock_guard&);
+
+  bool owns_lock()const noexcept{return owns;}
+
+private:
+  Mutex &m;
+  bool  owns;
+};
+
+/* Container-level shared access: either an announcement in the thread's
+ * quiescence record (see quiescence.hpp) or a shared lock on a mutex.
+ * Default-constructed objects own nothing, as failed non-blocking
+ * acquisitions.
+ */
+
+template<typename Mutex>
+class quiescent_shared_lock
+{
+public:
+  quiescent_shared_lock()noexcept{}
+  quiescent_shared_lock(quiescence_record* pr_,const void* t_)noexcept:
+    pr{pr_},t{t_}{}
+  quiescent_shared_lock(Mutex& m_,adopt_shared_lock_t)noexcept:pm{&m_}{}
+  ~quiescent_shared_lock()noexcept{release();}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  quiescent_shared_lock(const quiescent_shared_lock&);
+
+  void unlock(){BOOST_ASSERT(owns_lock());release();}
+  bool owns_lock()const noexcept{return pr||pm;}
+
+private:
+  void release()noexcept
+  {
+    if(pr){
+      pr->withdraw(t);
+      pr=nullptr;
+    }
+    else if(pm){
+      pm->unlock_shared();
+      pm=nullptr;
+    }
+  }
+
+  quiescence_record *pr=nullptr;
+  const void        *t=nullptr;
+  Mutex             *pm=nullptr;
+};
+
 /* inspired by boost/multi_index/detail/scoped_bilock.hpp */
 
 template<typename Mutex>
@@ -223,12 +334,39 @@ struct group_access
   using mutex_type=rw_spinlock;
   using shared_lock_guard=shared_lock<mutex_type>;
   using exclusive_lock_guard=lock_guard<mutex_type>;
+  using try_shared_lock_guard=try_shared_lock<mutex_type>;
+  using try_exclusive_lock_guard=try_lock_guard<mutex_type>;
   using insert_counter_type=std::atomic<boost::uint32_t>;
 
   shared_lock_guard    shared_access(){return shared_lock_guard{m};}
   exclusive_lock_guard exclusive_access(){return exclusive_lock_guard{m};}
   insert_counter_type& insert_counter(){return cnt;}
 
+  /* contention events reported to stats (see rw_spinlock::lock[_shared]) */
+
+  template<typename LockStats>
+  shared_lock_guard shared_access(LockStats&& stats)
+  {
+    m.lock_shared(stats);
+    return shared_lock_guard{m,adopt_shared_lock_t{}};
+  }
+
+  template<typename LockStats>
+  exclusive_lock_guard exclusive_access(LockStats&& stats)
+  {
+    return exclusive_lock_guard{m,stats};
+  }
+
+  try_shared_lock_guard try_shared_access()
+  {
+    return try_shared_lock_guard{m};
+  }
+
+  try_exclusive_lock_guard try_exclusive_access()
+  {
+    return try_exclusive_lock_guard{m};
+  }
+
 private:
   mutex_type          m;
   insert_counter_type cnt{0};
@@ -268,6 +406,21 @@ struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
     return boost::to_address(group_accesses_);
   }
 
+  std::size_t allocated_bytes()const noexcept
+  {
+    return this->elements()?
+      super::allocated_bytes()+
+        (this->groups_size_mask+1)*sizeof(group_access):0;
+  }
+
+  void add_memory_usage(memory_usage_info& res)const noexcept
+  {
+    super::add_memory_usage(res);
+    if(this->elements()){
+      res.locks+=(this->groups_size_mask+1)*sizeof(group_access);
+    }
+  }
+
   static concurrent_table_arrays new_(allocator_type al,std::size_t n)
   {
     super x{super::new_(al,n)};
@@ -374,6 +527,146 @@ inline void swap(atomic_size_control& x,atomic_size_control& y)
   swap_atomic_size_t(x.size,y.size);
 }
 
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+/* contention stats support */
+
+struct concurrent_table_contention_stats
+{
+  std::size_t              num_shared_lock_spins;
+  std::size_t              num_exclusive_lock_spins;
+  std::size_t              num_writer_pending_events;
+  std::size_t              num_insertion_restarts;
+  std::size_t              num_rehash_stalls;
+  std::chrono::nanoseconds rehash_stall_time;
+  std::size_t              num_exclusive_locks;
+  std::chrono::nanoseconds exclusive_lock_wait_time;
+};
+
+struct concurrent_table_stats:table_core_stats
+{
+  concurrent_table_contention_stats contention;
+};
+
+struct concurrent_table_cumulative_contention_stats
+{
+  using counter=std::atomic<std::size_t>;
+  using duration_counter=std::atomic<std::chrono::nanoseconds::rep>;
+
+  void reset()noexcept
+  {
+    for(auto pc:{
+      &num_shared_lock_spins,&num_exclusive_lock_spins,
+      &num_writer_pending_events,&num_insertion_restarts,
+      &num_rehash_stalls,&num_exclusive_locks}){
+      pc->store(0,std::memory_order_relaxed);
+    }
+    rehash_stall_time.store(0,std::memory_order_relaxed);
+    exclusive_lock_wait_time.store(0,std::memory_order_relaxed);
+  }
+
+  concurrent_table_contention_stats get_summary()const noexcept
+  {
+    return{
+      num_shared_lock_spins.load(std::memory_order_relaxed),
+      num_exclusive_lock_spins.load(std::memory_order_relaxed),
+      num_writer_pending_events.load(std::memory_order_relaxed),
+      num_insertion_restarts.load(std::memory_order_relaxed),
+      num_rehash_stalls.load(std::memory_order_relaxed),
+      std::chrono::nanoseconds{
+        rehash_stall_time.load(std::memory_order_relaxed)},
+      num_exclusive_locks.load(std::memory_order_relaxed),
+      std::chrono::nanoseconds{
+        exclusive_lock_wait_time.load(std::memory_order_relaxed)}
+    };
+  }
+
+  counter          num_shared_lock_spins{0},
+                   num_exclusive_lock_spins{0},
+                   num_writer_pending_events{0},
+                   num_insertion_restarts{0},
+                   num_rehash_stalls{0};
+  duration_counter rehash_stall_time{0};
+  counter          num_exclusive_locks{0};
+  duration_counter exclusive_lock_wait_time{0};
+};
+
+/* Records the duration of its own lifetime. */
+
+struct contention_stats_timer
+{
+  using counter=concurrent_table_cumulative_contention_stats::counter;
+  using duration_counter=
+    concurrent_table_cumulative_contention_stats::duration_counter;
+  using clock=std::chrono::steady_clock;
+
+  contention_stats_timer(counter& num_,duration_counter& time_)noexcept:
+    num{num_},time{time_}{}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  contention_stats_timer(const contention_stats_timer&);
+
+  ~contention_stats_timer()
+  {
+    num.fetch_add(1,std::memory_order_relaxed);
+    time.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now()-start).count(),
+      std::memory_order_relaxed);
+  }
+
+  counter&          num;
+  duration_counter& time;
+  clock::time_point start=clock::now();
+};
+
+/* Accumulates the contention events of a lock acquisition, which are dumped
+ * into the container stats on destruction so that uncontended acquisitions
+ * do not touch shared counters.
+ */
+
+struct lock_contention_stats
+{
+  using counter=concurrent_table_cumulative_contention_stats::counter;
+
+  lock_contention_stats(counter& spins_,counter& writer_pendings_)noexcept:
+    spins{spins_},writer_pendings{writer_pendings_}{}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  lock_contention_stats(const lock_contention_stats&);
+
+  ~lock_contention_stats()
+  {
+    if(num_spins)spins.fetch_add(num_spins,std::memory_order_relaxed);
+    if(num_writer_pendings){
+      writer_pendings.fetch_add(
+        num_writer_pendings,std::memory_order_relaxed);
+    }
+  }
+
+  void spin()noexcept{++num_spins;}
+  void writer_pending()noexcept{++num_writer_pendings;}
+
+  counter     &spins,&writer_pendings;
+  std::size_t num_spins=0,num_writer_pendings=0;
+};
+
+/* Container-level exclusive locking is also timed. */
+
+struct timed_lock_contention_stats:lock_contention_stats
+{
+  timed_lock_contention_stats(
+    concurrent_table_cumulative_contention_stats& cs)noexcept:
+    lock_contention_stats{
+      cs.num_exclusive_lock_spins,cs.num_writer_pending_events},
+    tmr{cs.num_exclusive_locks,cs.exclusive_lock_wait_time}{}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  timed_lock_contention_stats(const timed_lock_contention_stats&);
+
+  contention_stats_timer tmr;
+};
+#endif
+
 /* foa::concurrent_table serves as the foundation for end-user concurrent
  * hash containers.
  * 
@@ -395,7 +688,8 @@ inline void swap(atomic_size_control& x,atomic_size_control& y)
  *     operations of the form "X (and|or) Y", where X, Y are one of the
  *     primitives FIND, ACCESS, INSERT or ERASE.
  *   - Parallel versions of [c]visit_all(f) and erase_if(f) are provided based
- *     on C++17 stdlib parallel algorithms.
+ *     on C++17 stdlib parallel algorithms or, alternatively, on
+ *     boost::unordered::work_stealing_executor.
  * 
  * Consult boost::concurrent_(flat|node)_(map|set) docs for the full API
  * reference. Heterogeneous lookup is suported by default, that is, without
@@ -427,11 +721,82 @@ inline void swap(atomic_size_control& x,atomic_size_control& y)
  *       whole operation (which is checked by comparing with c0), then we're
  *       good to go and complete the insertion, otherwise we roll back and
  *       start over.
+ *
+ * Rehashing for growth upon insertion into a full table is cooperative:
+ * threads blocked on container-level shared access (including those also
+ * finding the table full) help the rehashing thread, which holds exclusive
+ * access, by claiming chunks of groups of the old bucket array and moving
+ * their elements into the new one, with insertion into the new groups
+ * protected by their group locks. The rehashing thread publishes the new
+ * arrays once all helpers are done. Elements whose transfer throws are
+ * destroyed, and the first such exception is propagated once the rest are
+ * transferred. Small tables and elements transferred by copy (see
+ * table_core::nosize_transfer_element) are rehashed by a single thread.
+ *
+ * In fixed-capacity mode (see constructor with fixed_capacity_t), the table is
+ * sized at construction time and never rehashed: insertion into a full table
+ * fails rather than waits for a rehash, and no thread ever blocks on or helps
+ * with a rehash. Container-level shared access does not lock: the thread
+ * announces the table in its quiescence record instead (see quiescence.hpp).
+ * Container-wide operations (assignment, swap, clear, copy, comparison, etc.)
+ * lock the container-level mutexes as usual and then mark the table as
+ * quiescing and wait for announcements on it to be withdrawn; threads
+ * finding the table quiescing fall back to locking and thus wait for the
+ * operation to complete. Fixed-capacity mode travels with the contents on
+ * swap and move assignment (the moved-from table reverts to regular mode),
+ * so that the max load compensation done on erasure always applies to
+ * fixed-capacity arrays; the access mode (qstate) is updated accordingly at
+ * the end of the exclusive operation.
+ * As there is no rehashing to reset the anti-drift mechanism of
+ * table_core::recover_slot, maximum load is kept constant upon erasure at
+ * the expense of potentially longer probe sequences.
+ *
+ * Snapshot visitation (cvisit_all(snapshot_t,f)) presents the elements as of
+ * the moment it starts while writers proceed concurrently. A snapshot keeps
+ * a state per group, initially pending. The visitor goes through groups in
+ * order and marks them as visited once done; a writer locking a pending group
+ * for modification first copies its elements aside (copy-on-write) and marks
+ * it as copied, so that the visitor later goes through the copies instead.
+ * Operations replacing the whole bucket array (rehashing, assignment,
+ * swap, etc.) copy all pending groups at once under the container-level
+ * lock. Copying code is only instantiated when snapshot visitation is used,
+ * as writers reach it through a function pointer stored in the snapshot.
+ *
+ * With epoch-based reclamation (see constructor with epoch_reclamation_t),
+ * meant for node-based tables, const single-key visitation runs the visitor
+ * after releasing the group lock, and erased elements are retired rather
+ * than destroyed, to be reclaimed once no reader can access them:
+ *
+ *   - A reader registers in the current global epoch e before releasing the
+ *     group lock, by incrementing one of two per-slot counters (e%2) in an
+ *     array of cache-aligned reader slots (the slot is chosen by thread),
+ *     and deregisters after visitation. If the global epoch changes between
+ *     its read and the increment, registration is retried.
+ *   - A writer erasing an element does so under the group's exclusive lock,
+ *     so any reader having found the element is already registered in an
+ *     epoch no later than the one at retirement time, r. The global epoch
+ *     advances from e to e+1 only when no reader is registered in e-1, so
+ *     elements retired in r can be destroyed once the epoch reaches r+2.
+ *   - Retired elements go to a list kept by the writer's slot under a
+ *     per-slot mutex, so that writers from different slots don't contend.
+ *     The global epoch is advanced with compare-and-swap by whichever writer
+ *     gets there first. Should retiring fail for lack of memory, the writer
+ *     waits for all current readers to finish and destroys the element
+ *     immediately.
+ *   - As readers don't hold the group lock while visiting, elements are
+ *     never modified in place: mutable visitation works on a copy of the
+ *     element which then replaces the original, retired as if erased.
+ *   - Readers keep holding container-level shared access during visitation,
+ *     so operations under exclusive access (rehashing, clear, assignment,
+ *     etc.) can reclaim all retired elements at once.
  */
 
 template<typename,typename,typename,typename>
 class table; /* concurrent/non-concurrent interop */
 
+template<typename,typename,typename,typename>
+class concurrent_clock_table; /* CLOCK-evicting cache on top of fixed capacity */
+
 template <typename TypePolicy,typename Hash,typename Pred,typename Allocator>
 using concurrent_table_core_impl=table_core<
   TypePolicy,group15<atomic_integral>,concurrent_table_arrays,
@@ -468,9 +833,10 @@ public:
   using allocator_type=typename super::allocator_type;
   using size_type=typename super::size_type;
   static constexpr std::size_t bulk_visit_size=16;
+  using layout_stats_type=typename super::layout_stats_type;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
-  using stats=typename super::stats;
+  using stats=concurrent_table_stats;
 #endif
 
 private:
@@ -488,12 +854,32 @@ public:
     super{n,h_,pred_,al_}
     {}
 
+  concurrent_table(
+    fixed_capacity_t,std::size_t n,const Hash& h_=Hash(),
+    const Pred& pred_=Pred(),const Allocator& al_=Allocator()):
+    super{0,h_,pred_,al_},fixed_capacity{true},qstate{quiescence_idle}
+  {
+    super::reserve(n);
+  }
+
+  concurrent_table(
+    epoch_reclamation_t,std::size_t n=default_bucket_count,
+    const Hash& h_=Hash(),const Pred& pred_=Pred(),
+    const Allocator& al_=Allocator()):
+    super{n,h_,pred_,al_},epochs{new_epoch_domain(this->al())}
+  {
+    BOOST_UNORDERED_STATIC_ASSERT(node_based::value);
+    BOOST_UNORDERED_STATIC_ASSERT(
+      (std::is_same<key_type,value_type>::value||
+       std::is_copy_constructible<value_type>::value));
+  }
+
   concurrent_table(const concurrent_table& x):
-    concurrent_table(x,x.exclusive_access()){}
+    concurrent_table(x,x.read_only_exclusive_access()){}
   concurrent_table(concurrent_table&& x):
     concurrent_table(std::move(x),x.exclusive_access()){}
   concurrent_table(const concurrent_table& x,const Allocator& al_):
-    concurrent_table(x,al_,x.exclusive_access()){}
+    concurrent_table(x,al_,x.read_only_exclusive_access()){}
   concurrent_table(concurrent_table&& x,const Allocator& al_):
     concurrent_table(std::move(x),al_,x.exclusive_access()){}
 
@@ -521,11 +907,16 @@ public:
     concurrent_table(std::move(x),x.make_empty_arrays())
   {}
 
-  ~concurrent_table()=default;
+  ~concurrent_table()
+  {
+    if(epochs)delete_epoch_domain();
+    discard_preallocated_arrays();
+  }
 
   concurrent_table& operator=(const concurrent_table& x)
   {
-    auto lck=exclusive_access(*this,x);
+    exclusive_bilock_guard<> lck{*this,x,true,false};
+    discard_preallocated_arrays();
     super::operator=(x);
     return *this;
   }
@@ -534,14 +925,18 @@ public:
     noexcept(std::declval<super&>() = std::declval<super&&>()))
   {
     auto lck=exclusive_access(*this,x);
+    discard_preallocated_arrays();
+    x.discard_preallocated_arrays();
     super::operator=(std::move(x));
+    fixed_capacity=x.fixed_capacity;
+    x.fixed_capacity=false;
     return *this;
   }
 
   concurrent_table& operator=(std::initializer_list<value_type> il) {
     auto lck=exclusive_access();
     super::clear();
-    super::noshrink_reserve(il.size());
+    if(!fixed_capacity)super::noshrink_reserve(il.size());
     for (auto const& v : il) {
       this->unprotected_emplace(v);
     }
@@ -593,6 +988,27 @@ public:
     return visit(first,last,std::forward<F>(f));
   }
 
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE
+  nonblocking_result visit(nonblocking_t,const Key& x,F&& f)
+  {
+    return nonblocking_visit_impl(group_exclusive{},x,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE
+  nonblocking_result visit(nonblocking_t,const Key& x,F&& f)const
+  {
+    return nonblocking_visit_impl(group_shared{},x,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE
+  nonblocking_result cvisit(nonblocking_t,const Key& x,F&& f)const
+  {
+    return visit(nonblocking_t{},x,std::forward<F>(f));
+  }
+
   template<typename F> std::size_t visit_all(F&& f)
   {
     return visit_all_impl(group_exclusive{},std::forward<F>(f));
@@ -608,7 +1024,47 @@ public:
     return visit_all(std::forward<F>(f));
   }
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+  template<typename F> std::size_t cvisit_all(snapshot_t,F&& f)const
+  {
+    snapshot_guard sg{*this};
+    auto&          s=sg.s;
+    std::size_t    res=0;
+    for(std::size_t pos=0;pos<s.num_groups;++pos){
+      auto& g=s.groups()[pos];
+      {
+        auto lck=shared_access();
+        if(g.state.load(std::memory_order_acquire)==snapshot_pending){
+          /* bucket array unchanged since the snapshot started */
+          auto glck=access(group_shared{},pos);
+          if(g.state.load(std::memory_order_relaxed)==snapshot_pending){
+            auto pg=this->arrays.groups()+pos;
+            auto p=this->arrays.elements()+pos*N;
+            auto mask=this->match_really_occupied(
+              pg,this->arrays.groups()+s.num_groups);
+            while(mask){
+              auto n=unchecked_countr_zero(mask);
+              f(cast_for(group_shared{},type_policy::value_from(p[n])));
+              ++res;
+              mask&=mask-1;
+            }
+            g.state.store(snapshot_visited,std::memory_order_relaxed);
+            continue;
+          }
+        }
+      }
+      /* copied (or failed) groups are immutable from now on */
+      if(g.state.load(std::memory_order_acquire)==snapshot_failed){
+        std::rethrow_exception(g.exception);
+      }
+      auto p=boost::to_address(g.elements);
+      for(std::size_t n=0;n<g.size;++n){
+        f(cast_for(group_shared{},type_policy::value_from(p[n])));
+        ++res;
+      }
+    }
+    return res;
+  }
+
   template<typename ExecutionPolicy,typename F>
   void visit_all(ExecutionPolicy&& policy,F&& f)
   {
@@ -630,6 +1086,52 @@ public:
   {
     visit_all(std::forward<ExecutionPolicy>(policy),std::forward<F>(f));
   }
+
+  template<typename T,typename BinaryOp,typename F>
+  T transform_reduce(T init,BinaryOp reduce,F transform)const
+  {
+    auto lck=shared_access();
+    for_all_elements(group_shared{},[&](element_type* p){
+      init=reduce(
+        std::move(init),
+        transform(cast_for(group_shared{},type_policy::value_from(*p))));
+    });
+    return init;
+  }
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+  template<typename ExecutionPolicy,typename T,typename BinaryOp,typename F>
+  T transform_reduce(
+    ExecutionPolicy&& policy,T init,BinaryOp reduce,F transform)const
+  {
+    using partial=partial_reduction<T>;
+
+    auto lck=shared_access();
+    if(!this->arrays.elements())return init;
+    auto first=this->arrays.groups(),
+         last=first+this->arrays.groups_size_mask+1;
+    return std::transform_reduce(
+      std::forward<ExecutionPolicy>(policy),first,last,partial{init},
+      [&](partial x,partial y){
+        return partial::combine(reduce,std::move(x),std::move(y));
+      },
+      [&,this](group_type& g){
+        auto   pos=static_cast<std::size_t>(&g-first);
+        auto   p=this->arrays.elements()+pos*N;
+        auto   glck=access(group_shared{},pos);
+        auto   mask=this->match_really_occupied(&g,last);
+        partial res{init};
+        while(mask){
+          auto n=unchecked_countr_zero(mask);
+          res.add(
+            reduce,
+            transform(cast_for(group_shared{},type_policy::value_from(p[n]))));
+          mask&=mask-1;
+        }
+        return res;
+      }
+    ).result(reduce,std::move(init));
+  }
 #endif
 
   template<typename F> bool visit_while(F&& f)
@@ -647,7 +1149,6 @@ public:
     return visit_while(std::forward<F>(f));
   }
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
   template<typename ExecutionPolicy,typename F>
   bool visit_while(ExecutionPolicy&& policy,F&& f)
   {
@@ -670,7 +1171,6 @@ public:
     return visit_while(
       std::forward<ExecutionPolicy>(policy),std::forward<F>(f));
   }
-#endif
 
   bool empty()const noexcept{return size()==0;}
   
@@ -732,6 +1232,15 @@ public:
   >::type
   insert(element_type&& x){return emplace_impl(std::move(x));}
 
+  template<typename InputIterator>
+  std::size_t insert(InputIterator first,InputIterator last)
+  {
+    std::size_t n;
+    return bulk_emplace_and_visit_impl(
+      group_shared{},first,last,
+      [](const value_type&){},[](const value_type&){},n);
+  }
+
   template<typename Key,typename... Args>
   BOOST_FORCEINLINE bool try_emplace(Key&& x,Args&&... args)
   {
@@ -786,67 +1295,153 @@ public:
   }
 
   template<typename... Args>
-  BOOST_FORCEINLINE bool emplace_and_visit(Args&&... args)
+  BOOST_FORCEINLINE
+  nonblocking_result emplace_or_visit(nonblocking_t,Args&&... args)
   {
-    return construct_and_emplace_and_visit_flast(
+    return nonblocking_construct_and_emplace_or_visit_flast(
       group_exclusive{},std::forward<Args>(args)...);
   }
 
   template<typename... Args>
-  BOOST_FORCEINLINE bool emplace_and_cvisit(Args&&... args)
+  BOOST_FORCEINLINE
+  nonblocking_result emplace_or_cvisit(nonblocking_t,Args&&... args)
   {
-    return construct_and_emplace_and_visit_flast(
+    return nonblocking_construct_and_emplace_or_visit_flast(
       group_shared{},std::forward<Args>(args)...);
   }
 
-  template<typename Value,typename F>
-  BOOST_FORCEINLINE bool insert_or_visit(Value&& x,F&& f)
+  template<typename F>
+  BOOST_FORCEINLINE nonblocking_result insert_or_visit(
+    nonblocking_t,const init_type& x,F&& f)
   {
-    return insert_and_visit(
-      std::forward<Value>(x),[](const value_type&){},std::forward<F>(f));
+    return nonblocking_emplace_or_visit_impl(
+      group_exclusive{},std::forward<F>(f),x);
   }
 
-  template<typename Value,typename F>
-  BOOST_FORCEINLINE bool insert_or_cvisit(Value&& x,F&& f)
+  template<typename F>
+  BOOST_FORCEINLINE nonblocking_result insert_or_cvisit(
+    nonblocking_t,const init_type& x,F&& f)
   {
-    return insert_and_cvisit(
-      std::forward<Value>(x),[](const value_type&){},std::forward<F>(f));
+    return nonblocking_emplace_or_visit_impl(
+      group_shared{},std::forward<F>(f),x);
   }
 
-  template<typename F1,typename F2>
-  BOOST_FORCEINLINE bool insert_and_visit(const init_type& x,F1&& f1,F2&& f2)
+  template<typename F>
+  BOOST_FORCEINLINE nonblocking_result insert_or_visit(
+    nonblocking_t,init_type&& x,F&& f)
   {
-    return emplace_and_visit_impl(
-      group_exclusive{},std::forward<F1>(f1),std::forward<F2>(f2),x);
+    return nonblocking_emplace_or_visit_impl(
+      group_exclusive{},std::forward<F>(f),std::move(x));
   }
 
-  template<typename F1,typename F2>
-  BOOST_FORCEINLINE bool insert_and_cvisit(const init_type& x,F1&& f1,F2&& f2)
+  template<typename F>
+  BOOST_FORCEINLINE nonblocking_result insert_or_cvisit(
+    nonblocking_t,init_type&& x,F&& f)
   {
-    return emplace_and_visit_impl(
-      group_shared{},std::forward<F1>(f1),std::forward<F2>(f2),x);
+    return nonblocking_emplace_or_visit_impl(
+      group_shared{},std::forward<F>(f),std::move(x));
   }
 
-  template<typename F1,typename F2>
-  BOOST_FORCEINLINE bool insert_and_visit(init_type&& x,F1&& f1,F2&& f2)
+  /* SFINAE tilts call ambiguities in favor of init_type */
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_visit(
+    nonblocking_t,const Value& x,F&& f)
+    ->enable_if_is_value_type<Value,nonblocking_result>
   {
-    return emplace_and_visit_impl(
-      group_exclusive{},std::forward<F1>(f1),std::forward<F2>(f2),
-      std::move(x));
+    return nonblocking_emplace_or_visit_impl(
+      group_exclusive{},std::forward<F>(f),x);
   }
 
-  template<typename F1,typename F2>
-  BOOST_FORCEINLINE bool insert_and_cvisit(init_type&& x,F1&& f1,F2&& f2)
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_cvisit(
+    nonblocking_t,const Value& x,F&& f)
+    ->enable_if_is_value_type<Value,nonblocking_result>
   {
-    return emplace_and_visit_impl(
-      group_shared{},std::forward<F1>(f1),std::forward<F2>(f2),std::move(x));
+    return nonblocking_emplace_or_visit_impl(
+      group_shared{},std::forward<F>(f),x);
   }
 
-  /* SFINAE tilts call ambiguities in favor of init_type */
-
-  template<typename Value,typename F1,typename F2>
-  BOOST_FORCEINLINE auto insert_and_visit(const Value& x,F1&& f1,F2&& f2)
-    ->enable_if_is_value_type<Value,bool>
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_visit(
+    nonblocking_t,Value&& x,F&& f)
+    ->enable_if_is_value_type<Value,nonblocking_result>
+  {
+    return nonblocking_emplace_or_visit_impl(
+      group_exclusive{},std::forward<F>(f),std::move(x));
+  }
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE auto insert_or_cvisit(
+    nonblocking_t,Value&& x,F&& f)
+    ->enable_if_is_value_type<Value,nonblocking_result>
+  {
+    return nonblocking_emplace_or_visit_impl(
+      group_shared{},std::forward<F>(f),std::move(x));
+  }
+
+  template<typename... Args>
+  BOOST_FORCEINLINE bool emplace_and_visit(Args&&... args)
+  {
+    return construct_and_emplace_and_visit_flast(
+      group_exclusive{},std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  BOOST_FORCEINLINE bool emplace_and_cvisit(Args&&... args)
+  {
+    return construct_and_emplace_and_visit_flast(
+      group_shared{},std::forward<Args>(args)...);
+  }
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE bool insert_or_visit(Value&& x,F&& f)
+  {
+    return insert_and_visit(
+      std::forward<Value>(x),[](const value_type&){},std::forward<F>(f));
+  }
+
+  template<typename Value,typename F>
+  BOOST_FORCEINLINE bool insert_or_cvisit(Value&& x,F&& f)
+  {
+    return insert_and_cvisit(
+      std::forward<Value>(x),[](const value_type&){},std::forward<F>(f));
+  }
+
+  template<typename F1,typename F2>
+  BOOST_FORCEINLINE bool insert_and_visit(const init_type& x,F1&& f1,F2&& f2)
+  {
+    return emplace_and_visit_impl(
+      group_exclusive{},std::forward<F1>(f1),std::forward<F2>(f2),x);
+  }
+
+  template<typename F1,typename F2>
+  BOOST_FORCEINLINE bool insert_and_cvisit(const init_type& x,F1&& f1,F2&& f2)
+  {
+    return emplace_and_visit_impl(
+      group_shared{},std::forward<F1>(f1),std::forward<F2>(f2),x);
+  }
+
+  template<typename F1,typename F2>
+  BOOST_FORCEINLINE bool insert_and_visit(init_type&& x,F1&& f1,F2&& f2)
+  {
+    return emplace_and_visit_impl(
+      group_exclusive{},std::forward<F1>(f1),std::forward<F2>(f2),
+      std::move(x));
+  }
+
+  template<typename F1,typename F2>
+  BOOST_FORCEINLINE bool insert_and_cvisit(init_type&& x,F1&& f1,F2&& f2)
+  {
+    return emplace_and_visit_impl(
+      group_shared{},std::forward<F1>(f1),std::forward<F2>(f2),std::move(x));
+  }
+
+  /* SFINAE tilts call ambiguities in favor of init_type */
+
+  template<typename Value,typename F1,typename F2>
+  BOOST_FORCEINLINE auto insert_and_visit(const Value& x,F1&& f1,F2&& f2)
+    ->enable_if_is_value_type<Value,bool>
   {
     return emplace_and_visit_impl(
       group_exclusive{},std::forward<F1>(f1),std::forward<F2>(f2),x);
@@ -902,10 +1497,110 @@ public:
       group_shared{},std::forward<F1>(f1),std::forward<F2>(f2),std::move(x));
   }
 
+  /* Range versions return the number of elements in [first,last), as
+   * required by the container-level insert_(or|and)_[c]visit overloads.
+   */
+
+  template<typename InputIterator,typename F>
+  std::size_t insert_or_visit(InputIterator first,InputIterator last,F&& f)
+  {
+    return insert_and_visit(
+      first,last,[](const value_type&){},std::forward<F>(f));
+  }
+
+  template<typename InputIterator,typename F>
+  std::size_t insert_or_cvisit(InputIterator first,InputIterator last,F&& f)
+  {
+    return insert_and_cvisit(
+      first,last,[](const value_type&){},std::forward<F>(f));
+  }
+
+  /* f is invoked with the element found and the value whose insertion was
+   * attempted. Returns the number of elements inserted.
+   */
+
+  template<typename InputIterator,typename F>
+  std::size_t insert_or_combine(InputIterator first,InputIterator last,F&& f)
+  {
+    std::size_t n;
+    value_visitor<F> f2{f};
+    return bulk_emplace_and_visit_impl(
+      group_exclusive{},first,last,[](const value_type&){},f2,n);
+  }
+
+  template<typename InputIterator,typename F1,typename F2>
+  std::size_t insert_and_visit(
+    InputIterator first,InputIterator last,F1&& f1,F2&& f2)
+  {
+    std::size_t n;
+    bulk_emplace_and_visit_impl(
+      group_exclusive{},first,last,
+      std::forward<F1>(f1),std::forward<F2>(f2),n);
+    return n;
+  }
+
+  template<typename InputIterator,typename F1,typename F2>
+  std::size_t insert_and_cvisit(
+    InputIterator first,InputIterator last,F1&& f1,F2&& f2)
+  {
+    std::size_t n;
+    bulk_emplace_and_visit_impl(
+      group_shared{},first,last,
+      std::forward<F1>(f1),std::forward<F2>(f2),n);
+    return n;
+  }
+
   template<typename Key>
   BOOST_FORCEINLINE std::size_t erase(const Key& x)
   {
-    return erase_if(x,[](const value_type&){return true;});
+    auto        lck=shared_access();
+    auto        hash=this->hash_for(x);
+    std::size_t res=0;
+    unprotected_internal_visit(
+      group_exclusive{},x,this->position_for(hash),hash,
+      [&,this](group_type* pg,unsigned int n,element_type* p)
+      {
+        erase_element(pg,n,p);
+        res=1;
+      });
+    return res;
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE nonblocking_result erase(nonblocking_t,const Key& x)
+  {
+    auto lck=try_shared_access();
+    if(BOOST_UNLIKELY(!acquired(lck)))return nonblocking_result::would_block;
+
+    auto hash=this->hash_for(x);
+    return unprotected_nonblocking_internal_visit(
+      group_exclusive{},x,this->position_for(hash),hash,
+      [this](group_type* pg,unsigned int n,element_type* p)
+        {erase_element(pg,n,p);});
+  }
+
+  template<typename FwdIterator>
+  BOOST_FORCEINLINE
+  std::size_t erase(FwdIterator first,FwdIterator last)
+  {
+    auto        lck=shared_access();
+    std::size_t res=0;
+    auto        n=static_cast<std::size_t>(std::distance(first,last));
+    while(n){
+      auto m=n<2*bulk_visit_size?n:bulk_visit_size;
+      res+=unprotected_internal_bulk_visit(
+        group_exclusive{},first,m,
+        [this](group_type* pg,unsigned int pos,element_type* p)
+        {
+          erase_element(pg,pos,p);
+        });
+      n-=m;
+      std::advance(
+        first,
+        static_cast<
+          typename std::iterator_traits<FwdIterator>::difference_type>(m));
+    }
+    return res;
   }
 
   template<typename Key,typename F>
@@ -919,8 +1614,8 @@ public:
       group_exclusive{},x,this->position_for(hash),hash,
       [&,this](group_type* pg,unsigned int n,element_type* p)
       {
-        if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          super::erase(pg,n,p);
+        if(test_element(group_exclusive{},f,p)){
+          erase_element(pg,n,p);
           res=1;
         }
       });
@@ -935,35 +1630,36 @@ public:
     for_all_elements(
       group_exclusive{},
       [&,this](group_type* pg,unsigned int n,element_type* p){
-        if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          super::erase(pg,n,p);
+        if(test_element(group_exclusive{},f,p)){
+          erase_element(pg,n,p);
           ++res;
         }
       });
     return res;
   }
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
   template<typename ExecutionPolicy,typename F>
   auto erase_if(ExecutionPolicy&& policy,F&& f)->typename std::enable_if<
-    is_execution_policy<ExecutionPolicy>::value,void>::type
+    is_parallel_executor<ExecutionPolicy>::value,void>::type
   {
     auto lck=shared_access();
     for_all_elements(
       group_exclusive{},std::forward<ExecutionPolicy>(policy),
       [&,this](group_type* pg,unsigned int n,element_type* p){
-        if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          super::erase(pg,n,p);
+        if(test_element(group_exclusive{},f,p)){
+          erase_element(pg,n,p);
         }
       });
   }
-#endif
 
   void swap(concurrent_table& x)
     noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
   {
     auto lck=exclusive_access(*this,x);
+    discard_preallocated_arrays();
+    x.discard_preallocated_arrays();
     super::swap(x);
+    std::swap(fixed_capacity,x.fixed_capacity);
   }
 
   void clear()noexcept
@@ -975,24 +1671,16 @@ public:
   template<typename Key,typename Extractor>
   BOOST_FORCEINLINE void extract(const Key& x,Extractor&& ext)
   {
-    extract_if(
-      x,[](const value_type&){return true;},std::forward<Extractor>(ext));
+    extract_if_impl(
+      x,[](element_type*){return true;},std::forward<Extractor>(ext));
   }
 
   template<typename Key,typename F,typename Extractor>
   BOOST_FORCEINLINE void extract_if(const Key& x,F&& f,Extractor&& ext)
   {
-    auto        lck=shared_access();
-    auto        hash=this->hash_for(x);
-    unprotected_internal_visit(
-      group_exclusive{},x,this->position_for(hash),hash,
-      [&,this](group_type* pg,unsigned int n,element_type* p)
-      {
-        if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          ext(std::move(*p),this->al());
-          super::erase(pg,n,p);
-        }
-      });
+    extract_if_impl(
+      x,[&,this](element_type* p){return test_element(group_exclusive{},f,p);},
+      std::forward<Extractor>(ext));
   }
 
   // TODO: should we accept different allocator too?
@@ -1066,21 +1754,280 @@ public:
 
   void rehash(std::size_t n)
   {
+    if(fixed_capacity)return;
     auto lck=exclusive_access();
     super::rehash(n);
   }
 
   void reserve(std::size_t n)
   {
+    if(fixed_capacity)return;
     auto lck=exclusive_access();
     super::reserve(n);
   }
 
+  bool has_fixed_capacity()const noexcept{return fixed_capacity;}
+
+  float preallocation_threshold()const noexcept
+  {
+    return prealloc_threshold.load(std::memory_order_relaxed);
+  }
+
+  void preallocation_threshold(float t)noexcept
+  {
+    if(!fixed_capacity)prealloc_threshold.store(t,std::memory_order_relaxed);
+  }
+
+  bool has_epoch_reclamation()const noexcept{return epochs!=nullptr;}
+
+  memory_usage_info memory_usage()const noexcept
+  {
+    auto lck=shared_access(); /* keeps the arrays in place */
+    auto res=super::memory_usage();
+    if(prealloc_state.load()==prealloc_ready){
+      preallocated.add_memory_usage(res);
+    }
+    if(epochs){
+      /* retired nodes are no longer counted by size() */
+      res.locks+=sizeof(epoch_domain);
+      for(std::size_t i=0;i<num_epoch_slots;++i){
+        auto&                  s=epochs->slots[i];
+        lock_guard<mutex_type> lcks{s.mtx};
+        res.nodes+=s.retired_size*sizeof(value_type);
+        res.locks+=s.retired_capacity*sizeof(retired_element);
+      }
+    }
+    res.total=res.group_metadata+res.element_slots+res.nodes+res.locks;
+    return res;
+  }
+
+  layout_stats_type layout_stats()const
+  {
+    /* keys are read to calculate probe lengths, so concurrent writers must be
+     * kept out also in fixed-capacity mode
+     */
+
+    auto lck=read_only_exclusive_access();
+    return super::layout_stats();
+  }
+
+  /* Non-concurrent interface over the table, passed to the function object
+   * of with_exclusive. Operations go directly to the internal arrays with no
+   * synchronization whatsoever, much as in the non-concurrent table, and the
+   * same iterator type is used.
+   */
+
+  class unsynchronized_view
+  {
+    using iterator_group_pointer=typename boost::pointer_traits<
+      typename boost::allocator_pointer<Allocator>::type
+    >::template rebind<group_type>;
+    using locator=typename super::locator;
+
+    static constexpr bool has_mutable_iterator=!std::is_same<
+      typename concurrent_table::key_type,
+      typename concurrent_table::value_type>::value;
+
+  public:
+    using key_type=typename concurrent_table::key_type;
+    using init_type=typename concurrent_table::init_type;
+    using value_type=typename concurrent_table::value_type;
+    using element_type=typename concurrent_table::element_type;
+    using size_type=typename concurrent_table::size_type;
+    using const_iterator=
+      table_iterator<type_policy,iterator_group_pointer,true>;
+    using iterator=typename std::conditional<
+      has_mutable_iterator,
+      table_iterator<type_policy,iterator_group_pointer,false>,
+      const_iterator>::type;
+
+    unsynchronized_view(const unsynchronized_view&)=delete;
+    unsynchronized_view& operator=(const unsynchronized_view&)=delete;
+
+    iterator begin()noexcept
+    {
+      iterator it{t.arrays.groups(),0,t.arrays.elements()};
+      if(t.arrays.elements()&&
+         !(t.arrays.groups()[0].match_occupied()&0x1))++it;
+      return it;
+    }
+
+    const_iterator begin()const noexcept
+      {return const_cast<unsynchronized_view*>(this)->begin();}
+    iterator       end()noexcept{return {};}
+    const_iterator end()const noexcept{return {};}
+    const_iterator cbegin()const noexcept{return begin();}
+    const_iterator cend()const noexcept{return end();}
+
+    bool        empty()const noexcept{return size()==0;}
+    std::size_t size()const noexcept{return t.unprotected_size();}
+    std::size_t max_size()const noexcept{return t.super::max_size();}
+
+    template<typename... Args>
+    BOOST_FORCEINLINE std::pair<iterator,bool> emplace(Args&&... args)
+    {
+      alloc_cted_insert_type<type_policy,Allocator,Args...> x(
+        t.al(),std::forward<Args>(args)...);
+      return emplace_impl(type_policy::move(x.value()));
+    }
+
+    template<typename Value>
+    BOOST_FORCEINLINE auto emplace(Value&& x)->typename std::enable_if<
+      detail::is_similar_to_any<Value,value_type,init_type>::value,
+      std::pair<iterator,bool>>::type
+    {
+      return emplace_impl(std::forward<Value>(x));
+    }
+
+    template<typename Key,typename... Args>
+    BOOST_FORCEINLINE std::pair<iterator,bool> try_emplace(
+      Key&& x,Args&&... args)
+    {
+      return emplace_impl(
+        try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+    }
+
+    BOOST_FORCEINLINE std::pair<iterator,bool>
+    insert(const init_type& x){return emplace_impl(x);}
+
+    BOOST_FORCEINLINE std::pair<iterator,bool>
+    insert(init_type&& x){return emplace_impl(std::move(x));}
+
+    template<typename=void>
+    BOOST_FORCEINLINE std::pair<iterator,bool>
+    insert(const value_type& x){return emplace_impl(x);}
+
+    template<typename=void>
+    BOOST_FORCEINLINE std::pair<iterator,bool>
+    insert(value_type&& x){return emplace_impl(std::move(x));}
+
+    template<
+      bool dependent_value=false,
+      typename std::enable_if<
+        has_mutable_iterator||dependent_value>::type* =nullptr
+    >
+    void erase(iterator pos)noexcept{erase(const_iterator(pos));}
+
+    BOOST_FORCEINLINE void erase(const_iterator pos)noexcept
+    {
+      t.erase_element(pos.pc(),pos.p());
+    }
+
+    template<typename Key>
+    BOOST_FORCEINLINE auto erase(const Key& x)->typename std::enable_if<
+      !std::is_convertible<Key,iterator>::value&&
+      !std::is_convertible<Key,const_iterator>::value,std::size_t>::type
+    {
+      auto loc=t.super::find(x);
+      if(!loc)return 0;
+      t.erase_element(loc.pg,loc.n,loc.p);
+      return 1;
+    }
+
+    void clear()noexcept{t.super::clear();}
+
+    template<typename Key>
+    BOOST_FORCEINLINE iterator find(const Key& x)
+    {
+      return make_iterator(t.super::find(x));
+    }
+
+    template<typename Key>
+    BOOST_FORCEINLINE const_iterator find(const Key& x)const
+    {
+      return const_cast<unsynchronized_view*>(this)->find(x);
+    }
+
+    template<typename Key>
+    BOOST_FORCEINLINE std::size_t count(const Key& x)const
+    {
+      return contains(x)?1:0;
+    }
+
+    template<typename Key>
+    BOOST_FORCEINLINE bool contains(const Key& x)const
+    {
+      return static_cast<bool>(t.super::find(x));
+    }
+
+    void rehash(std::size_t n){if(!t.fixed_capacity)t.super::rehash(n);}
+    void reserve(std::size_t n){if(!t.fixed_capacity)t.super::reserve(n);}
+
+  private:
+    friend concurrent_table;
+
+    unsynchronized_view(concurrent_table& t_):t(t_){}
+
+    static iterator make_iterator(const locator& l)noexcept
+    {
+      return {l.pg,l.n,l.p};
+    }
+
+    template<typename... Args>
+    BOOST_FORCEINLINE std::pair<iterator,bool> emplace_impl(Args&&... args)
+    {
+      const auto &k=t.key_from(std::forward<Args>(args)...);
+      auto        hash=t.hash_for(k);
+      auto        pos0=t.position_for(hash);
+      auto        loc=t.super::find(k,pos0,hash);
+
+      if(loc)return {make_iterator(loc),false};
+      if(BOOST_LIKELY(t.size_ctrl.size<t.size_ctrl.ml)){
+        return {
+          make_iterator(
+            t.unchecked_emplace_at(pos0,hash,std::forward<Args>(args)...)),
+          true
+        };
+      }
+      else if(t.fixed_capacity)return {end(),false};
+      else{
+        return {
+          make_iterator(
+            t.unchecked_emplace_with_rehash(hash,std::forward<Args>(args)...)),
+          true
+        };
+      }
+    }
+
+    concurrent_table& t;
+  };
+
+  /* Invokes f(v), with v an unsynchronized_view of *this, under exclusive
+   * access to the table. Meant for bulk phases where a single thread owns the
+   * container, so that each operation needs not pay for internal locking.
+   */
+
+  template<typename F>
+  auto with_exclusive(F&& f)
+    ->decltype(f(std::declval<unsynchronized_view&>()))
+  {
+    auto                lck=exclusive_access();
+    unsynchronized_view v{*this};
+    return f(v);
+  }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
-  /* already thread safe */
+  /* Contention stats belong to the container object and, unlike the rest,
+   * are not transferred on move construction/assignment or swap.
+   */
+
+  stats get_stats()const
+  {
+    stats res;
+    {
+      /* keeps the bucket array in place for group_occupancy() */
+      auto lck=shared_access();
+      static_cast<typename super::stats&>(res)=super::get_stats();
+    }
+    res.contention=ccstats.get_summary();
+    return res;
+  }
 
-  using super::get_stats;
-  using super::reset_stats;
+  void reset_stats()noexcept
+  {
+    super::reset_stats();
+    ccstats.reset();
+  }
 #endif
 
   template<typename Predicate>
@@ -1091,7 +2038,7 @@ public:
 
   friend bool operator==(const concurrent_table& x,const concurrent_table& y)
   {
-    auto lck=exclusive_access(x,y);
+    auto lck=read_only_exclusive_access(x,y);
     return static_cast<const super&>(x)==static_cast<const super&>(y);
   }
 
@@ -1102,68 +2049,262 @@ public:
 
 private:
   template<typename,typename,typename,typename> friend class concurrent_table;
+  template<typename,typename,typename,typename>
+  friend class concurrent_clock_table;
 
   using mutex_type=rw_spinlock;
   using multimutex_type=multimutex<mutex_type,128>; // TODO: adapt 128 to the machine
-  using shared_lock_guard=reentrancy_checked<shared_lock<mutex_type>>;
-  using exclusive_lock_guard=reentrancy_checked<lock_guard<multimutex_type>>;
-  using exclusive_bilock_guard=
-    reentrancy_bichecked<scoped_bilock<multimutex_type>>;
+  using shared_lock_guard=
+    reentrancy_checked<quiescent_shared_lock<mutex_type>>;
+  using try_shared_lock_guard=shared_lock_guard;
   using group_shared_lock_guard=typename group_access::shared_lock_guard;
-  using group_exclusive_lock_guard=typename group_access::exclusive_lock_guard;
+  using try_group_shared_lock_guard=
+    typename group_access::try_shared_lock_guard;
   using group_insert_counter_type=typename group_access::insert_counter_type;
 
-  concurrent_table(const concurrent_table& x,exclusive_lock_guard):
-    super{x}{}
-  concurrent_table(concurrent_table&& x,exclusive_lock_guard):
-    super{std::move(x)}{}
-  concurrent_table(
-    const concurrent_table& x,const Allocator& al_,exclusive_lock_guard):
-    super{x,al_}{}
-  concurrent_table(
-    concurrent_table&& x,const Allocator& al_,exclusive_lock_guard):
-    super{std::move(x),al_}{}
+  /* Exclusive lock guards preserve the contents of the table for any snapshot
+   * visitation in progress before modifications take place, unless acquired
+   * for reading only (copy source, comparison, etc.) As no reader can be
+   * accessing retired elements, these are reclaimed.
+   */
 
-  inline shared_lock_guard shared_access()const
+  struct exclusive_lock_guard:
+    reentrancy_checked<lock_guard<multimutex_type>>
   {
-    thread_local auto id=(++thread_counter)%mutexes.size();
-
-    return shared_lock_guard{this,mutexes[id]};
-  }
+    exclusive_lock_guard(const concurrent_table* t_,bool mutating=true):
+      reentrancy_checked<lock_guard<multimutex_type>>{
+        t_,t_->mutexes,t_->timed_exclusive_lock_stats()},
+      t{t_}
+    {
+      t->quiesce();
+      if(mutating)t->preserve_all_for_snapshot();
+      t->reclaim_all_retired();
+    }
 
-  inline exclusive_lock_guard exclusive_access()const
-  {
-    return exclusive_lock_guard{this,mutexes};
-  }
+    ~exclusive_lock_guard(){t->unquiesce();}
 
-  static inline exclusive_bilock_guard exclusive_access(
-    const concurrent_table& x,const concurrent_table& y)
-  {
-    return {&x,&y,x.mutexes,y.mutexes};
-  }
+    const concurrent_table *t;
+  };
 
-  template<typename Hash2,typename Pred2>
-  static inline exclusive_bilock_guard exclusive_access(
-    const concurrent_table& x,
-    const concurrent_table<TypePolicy,Hash2,Pred2,Allocator>& y)
+  template<typename Table=concurrent_table>
+  struct exclusive_bilock_guard:
+    reentrancy_bichecked<scoped_bilock<multimutex_type>>
   {
-    return {&x,&y,x.mutexes,y.mutexes};
-  }
+    exclusive_bilock_guard(
+      const concurrent_table& x_,const Table& y_,
+      bool x_mutating=true,bool y_mutating=true):
+      reentrancy_bichecked<scoped_bilock<multimutex_type>>{
+        &x_,&y_,x_.mutexes,y_.mutexes},
+      x{&x_},y{&y_}
+    {
+      x->quiesce();
+      if(!same())y->quiesce();
+      else x_mutating=y_mutating=x_mutating||y_mutating;
+      if(x_mutating)x->preserve_all_for_snapshot();
+      if(y_mutating)y->preserve_all_for_snapshot();
+      x->reclaim_all_retired();
+      y->reclaim_all_retired();
+    }
 
-  /* Tag-dispatched shared/exclusive group access */
+    ~exclusive_bilock_guard()
+    {
+      if(!same())y->unquiesce();
+      x->unquiesce();
+    }
+
+    bool same()const noexcept
+    {
+      return static_cast<const void*>(x)==static_cast<const void*>(y);
+    }
+
+    const concurrent_table *x;
+    const Table            *y;
+  };
+
+  struct group_exclusive_lock_guard
+  {
+    group_exclusive_lock_guard(const concurrent_table* t,std::size_t pos):
+      lck{t->arrays.group_accesses()[pos].exclusive_access(
+        t->exclusive_lock_stats())}
+    {
+      t->preserve_for_snapshot(pos);
+    }
+
+    /* not used but VS in pre-C++17 mode needs to see it for RVO */
+    group_exclusive_lock_guard(const group_exclusive_lock_guard&);
+
+    typename group_access::exclusive_lock_guard lck;
+  };
+
+  struct try_group_exclusive_lock_guard
+  {
+    try_group_exclusive_lock_guard(const concurrent_table* t,std::size_t pos):
+      lck{t->arrays.group_accesses()[pos].try_exclusive_access()}
+    {
+      if(lck.owns_lock())t->preserve_for_snapshot(pos);
+    }
+
+    /* not used but VS in pre-C++17 mode needs to see it for RVO */
+    try_group_exclusive_lock_guard(const try_group_exclusive_lock_guard&);
+
+    bool owns_lock()const noexcept{return lck.owns_lock();}
+
+    typename group_access::try_exclusive_lock_guard lck;
+  };
+
+  concurrent_table(const concurrent_table& x,exclusive_lock_guard):
+    super{x}{}
+  concurrent_table(concurrent_table&& x,exclusive_lock_guard):
+    super{std::move(x)}{}
+  concurrent_table(
+    const concurrent_table& x,const Allocator& al_,exclusive_lock_guard):
+    super{x,al_}{}
+  concurrent_table(
+    concurrent_table&& x,const Allocator& al_,exclusive_lock_guard):
+    super{std::move(x),al_}{}
+
+  enum quiescence_state:unsigned char
+  {
+    quiescence_off,quiescence_idle,quiescence_busy
+  };
+
+  /* Fixed-capacity tables announce themselves in the thread's quiescence
+   * record rather than lock the container-level mutex. Should the table be
+   * quiescing (or the record be unavailable), access falls back to locking,
+   * which blocks until the exclusive operation is done.
+   */
+
+  inline shared_lock_guard shared_access()const
+  {
+    if(qstate.load(std::memory_order_relaxed)!=quiescence_off){
+      auto pr=quiescent_access();
+      if(BOOST_LIKELY(pr!=nullptr))return shared_lock_guard{this,pr,this};
+    }
+
+    thread_local auto id=(++thread_counter)%mutexes.size();
+
+    auto& m=mutexes[id];
+    if(BOOST_UNLIKELY(!m.try_lock_shared()))lock_shared_or_help_rehash(m);
+    return shared_lock_guard{this,m,adopt_shared_lock_t{}};
+  }
+
+  /* Fails rather than blocks if the container is locked exclusively. */
+
+  inline try_shared_lock_guard try_shared_access()const
+  {
+    if(qstate.load(std::memory_order_relaxed)!=quiescence_off){
+      auto pr=quiescent_access();
+      if(BOOST_LIKELY(pr!=nullptr))return try_shared_lock_guard{this,pr,this};
+    }
+
+    thread_local auto id=(++thread_counter)%mutexes.size();
+
+    auto& m=mutexes[id];
+    for(int n=0;n<try_lock_attempts;++n){
+      if(m.try_lock_shared()){
+        return try_shared_lock_guard{this,m,adopt_shared_lock_t{}};
+      }
+    }
+    return try_shared_lock_guard{this};
+  }
+
+  inline quiescence_record* quiescent_access()const noexcept
+  {
+    auto pr=quiescence_registry::this_thread_record();
+    if(pr&&pr->announce(this)){
+      if(BOOST_LIKELY(
+        qstate.load(std::memory_order_acquire)==quiescence_idle))return pr;
+      pr->withdraw(this);
+    }
+    return nullptr;
+  }
+
+  /* Called with all container-level mutexes locked. Blocked readers wait on
+   * the mutexes, so quiesce/unquiesce need not synchronize among themselves.
+   */
+
+  void quiesce()const noexcept
+  {
+    if(qstate.load(std::memory_order_relaxed)==quiescence_off)return;
+    qstate.store(quiescence_busy,std::memory_order_relaxed);
+    heavy_barrier();
+    quiescence_registry::instance().wait_for_quiescence(this);
+  }
+
+  /* Fixed-capacity mode may have changed (swap, move assignment). */
+
+  void unquiesce()const noexcept
+  {
+    unsigned char s=fixed_capacity?quiescence_idle:quiescence_off;
+    if(qstate.load(std::memory_order_relaxed)!=s){
+      qstate.store(s,std::memory_order_release);
+    }
+  }
+
+  inline bool acquired(const try_shared_lock_guard& lck)const noexcept
+  {
+    return lck.lck.owns_lock();
+  }
+
+  inline exclusive_lock_guard exclusive_access()const
+  {
+    return exclusive_lock_guard{this};
+  }
+
+  inline exclusive_lock_guard read_only_exclusive_access()const
+  {
+    return exclusive_lock_guard{this,false};
+  }
+
+  static inline exclusive_bilock_guard<> read_only_exclusive_access(
+    const concurrent_table& x,const concurrent_table& y)
+  {
+    return {x,y,false,false};
+  }
+
+  static inline exclusive_bilock_guard<> exclusive_access(
+    const concurrent_table& x,const concurrent_table& y)
+  {
+    return {x,y};
+  }
+
+  template<typename Hash2,typename Pred2>
+  static inline
+  exclusive_bilock_guard<concurrent_table<TypePolicy,Hash2,Pred2,Allocator>>
+  exclusive_access(
+    const concurrent_table& x,
+    const concurrent_table<TypePolicy,Hash2,Pred2,Allocator>& y)
+  {
+    return {x,y};
+  }
+
+  /* Tag-dispatched shared/exclusive group access */
 
   using group_shared=std::false_type;
   using group_exclusive=std::true_type;
 
   inline group_shared_lock_guard access(group_shared,std::size_t pos)const
   {
-    return this->arrays.group_accesses()[pos].shared_access();
+    return this->arrays.group_accesses()[pos].shared_access(
+      shared_lock_stats());
   }
 
   inline group_exclusive_lock_guard access(
     group_exclusive,std::size_t pos)const
   {
-    return this->arrays.group_accesses()[pos].exclusive_access();
+    return {this,pos};
+  }
+
+  inline try_group_shared_lock_guard try_access(
+    group_shared,std::size_t pos)const
+  {
+    return this->arrays.group_accesses()[pos].try_shared_access();
+  }
+
+  inline try_group_exclusive_lock_guard try_access(
+    group_exclusive,std::size_t pos)const
+  {
+    return {this,pos};
   }
 
   inline group_insert_counter_type& insert_counter(std::size_t pos)const
@@ -1171,6 +2312,593 @@ private:
     return this->arrays.group_accesses()[pos].insert_counter();
   }
 
+  /* Contention stats support */
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  lock_contention_stats shared_lock_stats()const noexcept
+  {
+    return {ccstats.num_shared_lock_spins,ccstats.num_writer_pending_events};
+  }
+
+  lock_contention_stats exclusive_lock_stats()const noexcept
+  {
+    return {
+      ccstats.num_exclusive_lock_spins,ccstats.num_writer_pending_events};
+  }
+
+  timed_lock_contention_stats timed_exclusive_lock_stats()const noexcept
+  {
+    return {ccstats};
+  }
+
+  void add_insertion_restart_stats()const noexcept
+  {
+    ccstats.num_insertion_restarts.fetch_add(1,std::memory_order_relaxed);
+  }
+#else
+  static null_lock_stats shared_lock_stats()noexcept{return {};}
+  static null_lock_stats exclusive_lock_stats()noexcept{return {};}
+  static null_lock_stats timed_exclusive_lock_stats()noexcept{return {};}
+  static void add_insertion_restart_stats()noexcept{}
+#endif
+
+  /* Snapshot visitation machinery */
+
+  enum snapshot_group_state:unsigned char
+  {
+    snapshot_pending,snapshot_copied,snapshot_visited,snapshot_failed
+  };
+
+  using element_allocator_type=
+    typename boost::allocator_rebind<Allocator,element_type>::type;
+  using element_pointer=
+    typename boost::allocator_pointer<element_allocator_type>::type;
+
+  struct snapshot_group
+  {
+    std::atomic<unsigned char> state{snapshot_pending};
+    unsigned char              size=0;
+    element_pointer            elements=element_pointer();
+    std::exception_ptr         exception;
+  };
+
+  using snapshot_group_allocator_type=
+    typename boost::allocator_rebind<Allocator,snapshot_group>::type;
+  using snapshot_group_pointer=
+    typename boost::allocator_pointer<snapshot_group_allocator_type>::type;
+
+  struct snapshot_type
+  {
+    snapshot_type(const Allocator& al_,std::size_t num_groups_):
+      al{al_},num_groups{num_groups_}
+    {
+      if(num_groups){
+        snapshot_group_allocator_type gal(al);
+        groups_=boost::allocator_allocate(gal,num_groups);
+        for(std::size_t i=0;i<num_groups;++i)::new (groups()+i) snapshot_group;
+      }
+    }
+
+    snapshot_type(const snapshot_type&)=delete;
+    snapshot_type& operator=(const snapshot_type&)=delete;
+
+    ~snapshot_type()
+    {
+      if(num_groups){
+        element_allocator_type eal(al);
+        for(std::size_t i=0;i<num_groups;++i){
+          auto& g=groups()[i];
+          if(g.size){
+            auto p=boost::to_address(g.elements);
+            for(std::size_t n=0;n<g.size;++n)type_policy::destroy(al,p+n);
+            boost::allocator_deallocate(eal,g.elements,g.size);
+          }
+          g.~snapshot_group();
+        }
+        snapshot_group_allocator_type gal(al);
+        boost::allocator_deallocate(gal,groups_,num_groups);
+      }
+    }
+
+    snapshot_group* groups()const noexcept{return boost::to_address(groups_);}
+
+    /* Invoked under the group's exclusive lock or the container-level
+     * exclusive lock.
+     */
+
+    static void preserve_group(
+      snapshot_type& s,const concurrent_table& t,std::size_t pos)noexcept
+    {
+      auto& g=s.groups()[pos];
+      if(g.state.load(std::memory_order_relaxed)!=snapshot_pending)return;
+
+      auto        pg=t.arrays.groups()+pos;
+      auto        mask=concurrent_table::match_really_occupied(
+                    pg,t.arrays.groups()+s.num_groups);
+      auto        p=t.arrays.elements()+pos*N;
+      std::size_t size=0;
+      for(auto m=mask;m;m&=m-1)++size;
+
+      element_allocator_type eal(s.al);
+      element_type*          pe=nullptr;
+      std::size_t            n=0;
+      BOOST_TRY{
+        if(size){
+          g.elements=boost::allocator_allocate(eal,size);
+          pe=boost::to_address(g.elements);
+          for(;mask;mask&=mask-1){
+            type_policy::construct(
+              s.al,pe+n,
+              const_cast<const element_type&>(p[unchecked_countr_zero(mask)]));
+            ++n;
+          }
+        }
+        g.size=static_cast<unsigned char>(size);
+        g.state.store(snapshot_copied,std::memory_order_release);
+      }
+      BOOST_CATCH(...){
+        if(pe){
+          while(n)type_policy::destroy(s.al,pe+(--n));
+          boost::allocator_deallocate(eal,g.elements,size);
+          g.elements=element_pointer();
+        }
+        g.exception=std::current_exception();
+        g.state.store(snapshot_failed,std::memory_order_release);
+      }
+      BOOST_CATCH_END
+    }
+
+    Allocator              al;
+    std::size_t            num_groups;
+    snapshot_group_pointer groups_=snapshot_group_pointer();
+    std::atomic<bool>      all_preserved{false}; /* no pending groups left */
+
+    /* copying code is only instantiated if snapshot visitation is used */
+    void (*preserve)(snapshot_type&,const concurrent_table&,std::size_t)=
+      &preserve_group;
+  };
+
+  /* Publishes a snapshot for the lifetime of a snapshot visitation and
+   * retires it afterwards, waiting for writers possibly still using it.
+   */
+
+  struct snapshot_guard
+  {
+    /* Container-level shared access keeps the bucket array from being
+     * replaced until the snapshot is published, so that it is sized after
+     * the arrays it's visiting and later replacements preserve it.
+     */
+
+    snapshot_guard(const concurrent_table& t_):
+      t(t_),lck{t.snapshot_mutex},slck{t.shared_access()},
+      s{t.al(),t.arrays.elements()?t.arrays.groups_size_mask+1:0}
+    {
+      t.current_snapshot.store(&s,std::memory_order_release);
+      slck.unlock();
+    }
+
+    ~snapshot_guard()
+    {
+      auto slck=t.shared_access();
+      t.current_snapshot.store(nullptr);
+      if(t.arrays.elements()){
+        /* writers load current_snapshot under their group's lock */
+        for(std::size_t pos=0;pos<=t.arrays.groups_size_mask;++pos){
+          auto glck=t.arrays.group_accesses()[pos].exclusive_access();
+        }
+      }
+    }
+
+    const concurrent_table &t;
+    lock_guard<mutex_type>  lck;
+    shared_lock_guard       slck;
+    snapshot_type           s;
+  };
+
+  BOOST_FORCEINLINE void preserve_for_snapshot(std::size_t pos)const noexcept
+  {
+    auto ps=current_snapshot.load(std::memory_order_acquire);
+    if(BOOST_UNLIKELY(ps!=nullptr)&&
+       !ps->all_preserved.load(std::memory_order_relaxed)){
+      ps->preserve(*ps,*this,pos);
+    }
+  }
+
+  void preserve_all_for_snapshot()const noexcept
+  {
+    auto ps=current_snapshot.load(std::memory_order_acquire);
+    if(ps&&!ps->all_preserved.load(std::memory_order_relaxed)){
+      for(std::size_t pos=0;pos<ps->num_groups;++pos){
+        ps->preserve(*ps,*this,pos);
+      }
+      ps->all_preserved.store(true,std::memory_order_relaxed);
+    }
+  }
+
+  /* Epoch-based reclamation machinery */
+
+  using node_based=std::integral_constant<
+    bool,!std::is_same<element_type,value_type>::value>;
+
+  static constexpr std::size_t num_epoch_slots=128;
+
+  struct retired_element
+  {
+    retired_element(element_type&& x_,std::size_t epoch_)noexcept:
+      x(std::move(x_)),epoch(epoch_){}
+
+    element_type x;
+    std::size_t  epoch;
+  };
+
+  using retired_allocator_type=
+    typename boost::allocator_rebind<Allocator,retired_element>::type;
+  using retired_pointer=
+    typename boost::allocator_pointer<retired_allocator_type>::type;
+
+  /* Reader counters plus the list of elements retired by the threads
+   * assigned to the slot, protected by its own mutex.
+   */
+
+  struct epoch_slot
+  {
+    retired_element* retired()noexcept
+    {
+      return retired_buf?boost::to_address(retired_buf):nullptr;
+    }
+
+    std::atomic<std::size_t> readers[2];
+    mutex_type               mtx;
+    retired_pointer          retired_buf=retired_pointer();
+    std::size_t              retired_size=0;
+    std::size_t              retired_capacity=0;
+  };
+
+  struct epoch_domain
+  {
+    epoch_domain(const Allocator& al_):al{al_}
+    {
+      for(std::size_t i=0;i<num_epoch_slots;++i){
+        slots[i].readers[0].store(0,std::memory_order_relaxed);
+        slots[i].readers[1].store(0,std::memory_order_relaxed);
+      }
+    }
+
+    Allocator                                       al;
+    cache_aligned_array<epoch_slot,num_epoch_slots> slots;
+    std::atomic<std::size_t>                        epoch{0};
+  };
+
+  using epoch_domain_allocator_type=
+    typename boost::allocator_rebind<Allocator,epoch_domain>::type;
+  using epoch_domain_pointer=
+    typename boost::allocator_pointer<epoch_domain_allocator_type>::type;
+
+  static constexpr std::size_t retire_batch=64;
+
+  static epoch_domain* new_epoch_domain(const Allocator& al_)
+  {
+    epoch_domain_allocator_type dal(al_);
+    auto p=boost::allocator_allocate(dal,1);
+    BOOST_TRY{
+      return ::new (boost::to_address(p)) epoch_domain(al_);
+    }
+    BOOST_CATCH(...){
+      boost::allocator_deallocate(dal,p,1);
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+  }
+
+  void delete_epoch_domain()noexcept
+  {
+    reclaim_all_retired();
+    retired_allocator_type ral(epochs->al);
+    for(std::size_t i=0;i<num_epoch_slots;++i){
+      auto& s=epochs->slots[i];
+      if(s.retired_buf){
+        boost::allocator_deallocate(ral,s.retired_buf,s.retired_capacity);
+      }
+    }
+    epoch_domain_allocator_type dal(epochs->al);
+    epochs->~epoch_domain();
+    boost::allocator_deallocate(
+      dal,
+      boost::pointer_traits<epoch_domain_pointer>::pointer_to(*epochs),1);
+  }
+
+  static std::size_t this_thread_epoch_slot()noexcept
+  {
+    thread_local auto id=(++thread_counter)%num_epoch_slots;
+    return id;
+  }
+
+  /* Registration of a reader in the current epoch */
+
+  struct epoch_guard
+  {
+    epoch_guard()=default;
+    epoch_guard(const epoch_guard&)=delete;
+    epoch_guard& operator=(const epoch_guard&)=delete;
+    ~epoch_guard()
+    {
+      if(counter)counter->fetch_sub(1,std::memory_order_release);
+    }
+
+    void enter(epoch_domain& d)noexcept
+    {
+      auto& slot=d.slots[this_thread_epoch_slot()];
+      for(;;){
+        auto e=d.epoch.load();
+        counter=&slot.readers[e%2];
+        counter->fetch_add(1);
+        if(d.epoch.load()==e)return;
+        counter->fetch_sub(1);
+      }
+    }
+
+    std::atomic<std::size_t>* counter=nullptr;
+  };
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_reclaimable_visit(
+    group_exclusive access_mode,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {
+    return unprotected_visit(access_mode,x,pos0,hash,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_reclaimable_visit(
+    group_shared access_mode,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {
+    if(BOOST_LIKELY(!epochs)){
+      return unprotected_visit(access_mode,x,pos0,hash,std::forward<F>(f));
+    }
+
+    epoch_guard       g;
+    const value_type* pv=nullptr;
+    auto              res=unprotected_visit(
+      group_shared{},x,pos0,hash,[&,this](const value_type& v){
+        g.enter(*epochs);
+        pv=std::addressof(v);
+      });
+    if(res)f(*pv); /* group lock released, node kept alive by g */
+    return res;
+  }
+
+  static bool epoch_drained(epoch_domain& d,std::size_t e)noexcept
+  {
+    for(std::size_t i=0;i<num_epoch_slots;++i){
+      if(d.slots[i].readers[e%2].load()!=0)return false;
+    }
+    return true;
+  }
+
+  /* Advances the global epoch from e to e+1 if no reader is registered in
+   * e-1. Threads retiring from different slots may race to advance it, hence
+   * compare-and-swap. Returns the current epoch.
+   */
+
+  static std::size_t try_advance_epoch(epoch_domain& d,std::size_t e)noexcept
+  {
+    if(epoch_drained(d,e+1)&&d.epoch.compare_exchange_strong(e,e+1))++e;
+    return e;
+  }
+
+  /* Invoked under the group's exclusive lock. Ownership of the node is
+   * transferred to the retired list of the thread's slot so that super::erase
+   * only frees the slot.
+   */
+
+  void retire_element(element_type*,std::false_type)noexcept{}
+
+  void retire_element(element_type* p,std::true_type)noexcept
+  {
+    auto&                  d=*epochs;
+    auto&                  s=d.slots[this_thread_epoch_slot()];
+    lock_guard<mutex_type> lck{s.mtx};
+    if(s.retired_size==s.retired_capacity){
+      BOOST_TRY{
+        grow_retired(d,s);
+      }
+      BOOST_CATCH(...){
+        /* destroy the element right away, super::erase takes care */
+        synchronize_epochs(d);
+        return;
+      }
+      BOOST_CATCH_END
+    }
+    ::new (s.retired()+s.retired_size) retired_element(
+      std::move(*p),d.epoch.load());
+    if(++s.retired_size%retire_batch==0)reclaim_retired(d,s);
+  }
+
+  static void grow_retired(epoch_domain& d,epoch_slot& s)
+  {
+    retired_allocator_type ral(d.al);
+    auto                   capacity=s.retired_capacity*2+retire_batch;
+    auto                   buf=boost::allocator_allocate(ral,capacity);
+    auto                   pr=boost::to_address(buf);
+    for(std::size_t i=0;i<s.retired_size;++i){
+      ::new (pr+i) retired_element(std::move(s.retired()[i]));
+      s.retired()[i].~retired_element();
+    }
+    if(s.retired_buf){
+      boost::allocator_deallocate(ral,s.retired_buf,s.retired_capacity);
+    }
+    s.retired_buf=buf;
+    s.retired_capacity=capacity;
+  }
+
+  /* Waits until all readers registered at the time of invocation are done.
+   * Used when the element is to leave the retirement scheme (extraction).
+   */
+
+  void synchronize_epochs()noexcept{synchronize_epochs(*epochs);}
+
+  static void synchronize_epochs(epoch_domain& d)noexcept
+  {
+    auto e=d.epoch.load(),target=e+2;
+    while(e<target){
+      auto e2=try_advance_epoch(d,e);
+      if(e2==e)boost::core::sp_thread_yield();
+      e=e2;
+    }
+  }
+
+  /* Invoked under s.mtx. Retirement epochs are non-decreasing along
+   * the retired list of a slot.
+   */
+
+  void reclaim_retired(epoch_domain& d,epoch_slot& s)noexcept
+  {
+    auto e=d.epoch.load();
+    for(int i=0;i<2;++i)e=try_advance_epoch(d,e);
+
+    Allocator   al_(this->al());
+    auto        pr=s.retired();
+    std::size_t n=0;
+    for(;n<s.retired_size&&pr[n].epoch+2<=e;++n){
+      type_policy::destroy(al_,&pr[n].x);
+      pr[n].~retired_element();
+    }
+    if(n==0)return;
+    for(std::size_t i=n;i<s.retired_size;++i){
+      ::new (pr+i-n) retired_element(std::move(pr[i]));
+      pr[i].~retired_element();
+    }
+    s.retired_size-=n;
+  }
+
+  /* Invoked when no reader can be registered (exclusive access, destruction).
+   */
+
+  void reclaim_all_retired()const noexcept
+  {
+    if(!epochs)return;
+    Allocator al_(this->al());
+    for(std::size_t i=0;i<num_epoch_slots;++i){
+      auto& s=epochs->slots[i];
+      auto  pr=s.retired();
+      for(std::size_t j=0;j<s.retired_size;++j){
+        type_policy::destroy(al_,&pr[j].x);
+        pr[j].~retired_element();
+      }
+      s.retired_size=0;
+    }
+  }
+
+  /* With epoch-based reclamation, const visitation of a single element runs
+   * without the group lock, so mutable visitation can't modify the element
+   * in place: the visitation function is passed a copy of the element,
+   * which then replaces the original, retired as if erased. If the function
+   * throws, the original is left untouched. Set-like tables are never
+   * mutably visited and need no replacement.
+   */
+
+  template<typename Value=value_type> /* lazy, value_type may be incomplete */
+  using replace_on_visit=std::integral_constant<
+    bool,
+    node_based::value&&!std::is_same<key_type,Value>::value&&
+    std::is_copy_constructible<Value>::value>;
+
+  struct element_replacement
+  {
+    element_replacement(concurrent_table& t_,element_type* p_):
+      t(t_),p{p_},al_(t.al())
+    {
+      type_policy::construct(al_,&x,static_cast<const element_type&>(*p));
+    }
+
+    ~element_replacement()
+    {
+      /* not committed or retirement failed */
+      type_policy::destroy(al_,&x);
+    }
+
+    value_type& value()noexcept{return type_policy::value_from(x);}
+
+    void commit()noexcept
+    {
+      x.swap(*p);
+      t.retire_element(&x,node_based{});
+    }
+
+    concurrent_table &t;
+    element_type     *p;
+    Allocator        al_;
+    element_type     x;
+  };
+
+  template<typename F>
+  BOOST_FORCEINLINE void visit_element(
+    group_shared,F&& f,element_type* p)const
+  {
+    f(cast_for(group_shared{},type_policy::value_from(*p)));
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE void visit_element(
+    group_exclusive,F&& f,element_type* p)const
+  {
+    if(BOOST_UNLIKELY(epochs!=nullptr)){
+      const_cast<concurrent_table*>(this)->
+        replace_and_visit(f,p,replace_on_visit<>{});
+    }
+    else f(cast_for(group_exclusive{},type_policy::value_from(*p)));
+  }
+
+  template<typename F>
+  void replace_and_visit(F& f,element_type* p,std::false_type)
+  {
+    f(cast_for(group_exclusive{},type_policy::value_from(*p)));
+  }
+
+  template<typename F>
+  void replace_and_visit(F& f,element_type* p,std::true_type)
+  {
+    element_replacement r{*this,p};
+    f(r.value());
+    r.commit();
+  }
+
+  /* Same as visit_element for visitation functions returning bool */
+
+  template<typename F>
+  BOOST_FORCEINLINE bool test_element(
+    group_shared,F&& f,element_type* p)const
+  {
+    return f(cast_for(group_shared{},type_policy::value_from(*p)));
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool test_element(
+    group_exclusive,F&& f,element_type* p)const
+  {
+    if(BOOST_UNLIKELY(epochs!=nullptr)){
+      return const_cast<concurrent_table*>(this)->
+        replace_and_test(f,p,replace_on_visit<>{});
+    }
+    return f(cast_for(group_exclusive{},type_policy::value_from(*p)));
+  }
+
+  template<typename F>
+  bool replace_and_test(F& f,element_type* p,std::false_type)
+  {
+    return f(cast_for(group_exclusive{},type_policy::value_from(*p)));
+  }
+
+  template<typename F>
+  bool replace_and_test(F& f,element_type* p,std::true_type)
+  {
+    element_replacement r{*this,p};
+    bool                res=f(r.value());
+    r.commit();
+    return res;
+  }
+
   /* Const casts value_type& according to the level of group access for
    * safe passing to visitation functions. When type_policy is set-like,
    * access is always const regardless of group access.
@@ -1186,13 +2914,49 @@ private:
   >::type
   cast_for(group_exclusive,value_type& x){return x;}
 
+  template<typename Key,typename F,typename Extractor>
+  BOOST_FORCEINLINE void extract_if_impl(const Key& x,F&& f,Extractor&& ext)
+  {
+    auto        lck=shared_access();
+    auto        hash=this->hash_for(x);
+    unprotected_internal_visit(
+      group_exclusive{},x,this->position_for(hash),hash,
+      [&,this](group_type* pg,unsigned int n,element_type* p)
+      {
+        if(f(p)){
+          if(BOOST_UNLIKELY(epochs!=nullptr))synchronize_epochs();
+          ext(std::move(*p),this->al());
+          erase_element(pg,n,p);
+        }
+      });
+  }
+
+  void erase_element(group_type* pg,unsigned int pos,element_type* p)noexcept
+  {
+    if(fixed_capacity&&group_type::maybe_caused_overflow(
+      reinterpret_cast<unsigned char*>(pg)+pos)){
+      ++this->size_ctrl.ml; /* compensates anti-drift in recover_slot */
+    }
+    if(BOOST_UNLIKELY(epochs!=nullptr))retire_element(p,node_based{});
+    super::erase(pg,pos,p);
+  }
+
+  void erase_element(unsigned char* pc,element_type* p)noexcept
+  {
+    if(fixed_capacity&&group_type::maybe_caused_overflow(pc)){
+      ++this->size_ctrl.ml; /* compensates anti-drift in recover_slot */
+    }
+    if(BOOST_UNLIKELY(epochs!=nullptr))retire_element(p,node_based{});
+    super::erase(pc,p);
+  }
+
   struct erase_on_exit
   {
     erase_on_exit(
       concurrent_table& x_,
       group_type* pg_,unsigned int pos_,element_type* p_):
       x(x_),pg(pg_),pos(pos_),p(p_){}
-    ~erase_on_exit(){if(!rollback_)x.super::erase(pg,pos,p);}
+    ~erase_on_exit(){if(!rollback_)x.erase_element(pg,pos,p);}
 
     void rollback(){rollback_=true;}
 
@@ -1209,10 +2973,24 @@ private:
   {
     auto lck=shared_access();
     auto hash=this->hash_for(x);
-    return unprotected_visit(
+    return unprotected_reclaimable_visit(
       access_mode,x,this->position_for(hash),hash,std::forward<F>(f));
   }
 
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE nonblocking_result nonblocking_visit_impl(
+    GroupAccessMode access_mode,const Key& x,F&& f)const
+  {
+    auto lck=try_shared_access();
+    if(BOOST_UNLIKELY(!acquired(lck)))return nonblocking_result::would_block;
+
+    auto hash=this->hash_for(x);
+    return unprotected_nonblocking_internal_visit(
+      access_mode,x,this->position_for(hash),hash,
+      [&](group_type*,unsigned int,element_type* p)
+        {visit_element(access_mode,f,p);});
+  }
+
   template<typename GroupAccessMode,typename FwdIterator,typename F>
   BOOST_FORCEINLINE
   std::size_t bulk_visit_impl(
@@ -1239,13 +3017,12 @@ private:
     auto lck=shared_access();
     std::size_t res=0;
     for_all_elements(access_mode,[&](element_type* p){
-      f(cast_for(access_mode,type_policy::value_from(*p)));
+      visit_element(access_mode,f,p);
       ++res;
     });
     return res;
   }
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
   template<typename GroupAccessMode,typename ExecutionPolicy,typename F>
   void visit_all_impl(
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F&& f)const
@@ -1254,21 +3031,19 @@ private:
     for_all_elements(
       access_mode,std::forward<ExecutionPolicy>(policy),
       [&](element_type* p){
-        f(cast_for(access_mode,type_policy::value_from(*p)));
+        visit_element(access_mode,f,p);
       });
   }
-#endif
 
   template<typename GroupAccessMode,typename F>
   bool visit_while_impl(GroupAccessMode access_mode,F&& f)const
   {
     auto lck=shared_access();
     return for_all_elements_while(access_mode,[&](element_type* p){
-      return f(cast_for(access_mode,type_policy::value_from(*p)));
+      return test_element(access_mode,f,p);
     });
   }
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
   template<typename GroupAccessMode,typename ExecutionPolicy,typename F>
   bool visit_while_impl(
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F&& f)const
@@ -1277,10 +3052,9 @@ private:
     return for_all_elements_while(
       access_mode,std::forward<ExecutionPolicy>(policy),
       [&](element_type* p){
-        return f(cast_for(access_mode,type_policy::value_from(*p)));
+        return test_element(access_mode,f,p);
       });
   }
-#endif
 
   template<typename GroupAccessMode,typename Key,typename F>
   BOOST_FORCEINLINE std::size_t unprotected_visit(
@@ -1290,21 +3064,63 @@ private:
     return unprotected_internal_visit(
       access_mode,x,pos0,hash,
       [&](group_type*,unsigned int,element_type* p)
-        {f(cast_for(access_mode,type_policy::value_from(*p)));});
+        {visit_element(access_mode,f,p);});
+  }
+
+#if defined(BOOST_MSVC)
+/* warning: forcing value to bool 'true' or 'false' in bool(pred()...) */
+#pragma warning(push)
+#pragma warning(disable:4800)
+#endif
+
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_internal_visit(
+    GroupAccessMode access_mode,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {    
+    BOOST_UNORDERED_STATS_COUNTER(num_cmps);
+    prober pb(pos0);
+    do{
+      auto pos=pb.get();
+      auto pg=this->arrays.groups()+pos;
+      auto mask=pg->match(hash);
+      if(mask){
+        auto p=this->arrays.elements()+pos*N;
+        BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
+        auto lck=access(access_mode,pos);
+        do{
+          auto n=unchecked_countr_zero(mask);
+          if(BOOST_LIKELY(pg->is_occupied(n))){
+            BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
+            if(BOOST_LIKELY(bool(this->pred()(x,this->key_from(p[n]))))){
+              f(pg,n,p+n);
+              BOOST_UNORDERED_ADD_STATS(
+                this->cstats.successful_lookup,(pb.length(),num_cmps));
+              return 1;
+            }
+          }
+          mask&=mask-1;
+        }while(mask);
+      }
+      if(BOOST_LIKELY(pg->is_not_overflowed(hash))){
+        BOOST_UNORDERED_ADD_STATS(
+          this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+        return 0;
+      }
+    }
+    while(BOOST_LIKELY(pb.next(this->arrays.groups_size_mask)));
+    BOOST_UNORDERED_ADD_STATS(
+      this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+    return 0;
   }
 
-#if defined(BOOST_MSVC)
-/* warning: forcing value to bool 'true' or 'false' in bool(pred()...) */
-#pragma warning(push)
-#pragma warning(disable:4800)
-#endif
+  /* Same as unprotected_internal_visit, but group locking is non-blocking */
 
   template<typename GroupAccessMode,typename Key,typename F>
-  BOOST_FORCEINLINE std::size_t unprotected_internal_visit(
+  BOOST_FORCEINLINE nonblocking_result unprotected_nonblocking_internal_visit(
     GroupAccessMode access_mode,
     const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
-  {    
-    BOOST_UNORDERED_STATS_COUNTER(num_cmps);
+  {
     prober pb(pos0);
     do{
       auto pos=pb.get();
@@ -1313,36 +3129,42 @@ private:
       if(mask){
         auto p=this->arrays.elements()+pos*N;
         BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
-        auto lck=access(access_mode,pos);
+        auto lck=try_access(access_mode,pos);
+        if(BOOST_UNLIKELY(!lck.owns_lock())){
+          return nonblocking_result::would_block;
+        }
         do{
           auto n=unchecked_countr_zero(mask);
           if(BOOST_LIKELY(pg->is_occupied(n))){
-            BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
             if(BOOST_LIKELY(bool(this->pred()(x,this->key_from(p[n]))))){
               f(pg,n,p+n);
-              BOOST_UNORDERED_ADD_STATS(
-                this->cstats.successful_lookup,(pb.length(),num_cmps));
-              return 1;
+              return nonblocking_result::found;
             }
           }
           mask&=mask-1;
         }while(mask);
       }
       if(BOOST_LIKELY(pg->is_not_overflowed(hash))){
-        BOOST_UNORDERED_ADD_STATS(
-          this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
-        return 0;
+        return nonblocking_result::not_found;
       }
     }
     while(BOOST_LIKELY(pb.next(this->arrays.groups_size_mask)));
-    BOOST_UNORDERED_ADD_STATS(
-      this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
-    return 0;
+    return nonblocking_result::not_found;
   }
 
- template<typename GroupAccessMode,typename FwdIterator,typename F>
+  template<typename GroupAccessMode,typename FwdIterator,typename F>
   BOOST_FORCEINLINE std::size_t unprotected_bulk_visit(
     GroupAccessMode access_mode,FwdIterator first,std::size_t m,F&& f)const
+  {
+    return unprotected_internal_bulk_visit(
+      access_mode,first,m,
+      [&](group_type*,unsigned int,element_type* p)
+        {visit_element(access_mode,f,p);});
+  }
+
+  template<typename GroupAccessMode,typename FwdIterator,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_internal_bulk_visit(
+    GroupAccessMode access_mode,FwdIterator first,std::size_t m,F&& f)const
   {
     BOOST_ASSERT(m<2*bulk_visit_size);
 
@@ -1387,7 +3209,7 @@ private:
             if(BOOST_LIKELY(pg->is_occupied(n))){
               BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
               if(bool(this->pred()(*it,this->key_from(p[n])))){
-                f(cast_for(access_mode,type_policy::value_from(p[n])));
+                f(pg,n,p+n);
                 ++res;
                 BOOST_UNORDERED_ADD_STATS(
                   this->cstats.successful_lookup,(pb.length(),num_cmps));
@@ -1459,6 +3281,31 @@ private:
     );
   }
 
+  struct call_nonblocking_construct_and_emplace_or_visit
+  {
+    template<typename... Args>
+    BOOST_FORCEINLINE nonblocking_result operator()(
+      concurrent_table* this_,Args&&... args)const
+    {
+      return this_->nonblocking_construct_and_emplace_or_visit(
+        std::forward<Args>(args)...);
+    }
+  };
+
+  template<typename GroupAccessMode,typename... Args>
+  BOOST_FORCEINLINE nonblocking_result
+  nonblocking_construct_and_emplace_or_visit_flast(
+    GroupAccessMode access_mode,Args&&... args)
+  {
+    return mp11::tuple_apply(
+      call_nonblocking_construct_and_emplace_or_visit{},
+      std::tuple_cat(
+        std::make_tuple(this,access_mode),
+        tuple_rotate_right(std::forward_as_tuple(std::forward<Args>(args)...))
+      )
+    );
+  }
+
   struct call_construct_and_emplace_and_visit
   {
     template<typename... Args>
@@ -1504,7 +3351,10 @@ private:
     int res=unprotected_norehash_emplace_and_visit(
       access_mode,std::forward<F1>(f1),std::forward<F2>(f2),
       type_policy::move(x.value()));
-    if(BOOST_LIKELY(res>=0))return res!=0;
+    if(BOOST_LIKELY(res>=0)||fixed_capacity){
+      preallocate_if_due();
+      return res>0;
+    }
 
     lck.unlock();
 
@@ -1604,7 +3454,220 @@ private:
         int res=unprotected_norehash_emplace_and_visit(
           access_mode,std::forward<F1>(f1),std::forward<F2>(f2),
           std::forward<Args>(args)...);
-        if(BOOST_LIKELY(res>=0))return res!=0;
+        if(BOOST_LIKELY(res>=0)||fixed_capacity){
+          preallocate_if_due();
+          return res>0;
+        }
+      }
+      rehash_if_full();
+    }
+  }
+
+  template<typename GroupAccessMode,typename F,typename... Args>
+  BOOST_FORCEINLINE nonblocking_result nonblocking_construct_and_emplace_or_visit(
+    GroupAccessMode access_mode,F&& f,Args&&... args)
+  {
+    auto lck=try_shared_access();
+    if(BOOST_UNLIKELY(!acquired(lck)))return nonblocking_result::would_block;
+
+    alloc_cted_insert_type<type_policy,Allocator,Args...> x(
+      this->al(),std::forward<Args>(args)...);
+    return unprotected_nonblocking_emplace_or_visit(
+      access_mode,std::forward<F>(f),type_policy::move(x.value()));
+  }
+
+  template<typename GroupAccessMode,typename F,typename... Args>
+  BOOST_FORCEINLINE nonblocking_result nonblocking_emplace_or_visit_impl(
+    GroupAccessMode access_mode,F&& f,Args&&... args)
+  {
+    auto lck=try_shared_access();
+    if(BOOST_UNLIKELY(!acquired(lck)))return nonblocking_result::would_block;
+
+    return unprotected_nonblocking_emplace_or_visit(
+      access_mode,std::forward<F>(f),std::forward<Args>(args)...);
+  }
+
+  template<typename InputIterator>
+  using is_bulk_emplaceable_iterator=std::integral_constant<
+    bool,
+    std::is_base_of<
+      std::forward_iterator_tag,
+      typename std::iterator_traits<InputIterator>::iterator_category
+    >::value&&
+    detail::is_similar_to_any<
+      typename std::iterator_traits<InputIterator>::reference,
+      value_type,init_type
+    >::value
+  >;
+
+  /* Visitation function passed down by insert_or_combine, bound to the value
+   * being inserted by bind_value_visitor.
+   */
+
+  template<typename F>
+  struct value_visitor
+  {
+    F& f;
+  };
+
+  template<typename F,typename Value>
+  struct bound_value_visitor
+  {
+    template<typename T>
+    void operator()(T&& x)const{f(std::forward<T>(x),std::forward<Value>(v));}
+
+    F&      f;
+    Value&& v;
+  };
+
+  template<typename F,typename Value>
+  static F& bind_value_visitor(F& f,Value&&){return f;}
+
+  template<typename F,typename Value>
+  static bound_value_visitor<F,Value>
+  bind_value_visitor(value_visitor<F>& f,Value&& x)
+  {
+    return {f.f,std::forward<Value>(x)};
+  }
+
+  /* Returns the number of elements inserted and sets n to the number of
+   * elements in [first,last). Forward ranges of value_type/init_type are
+   * processed in chunks of at most 2*bulk_visit_size-1 elements, each under
+   * a single container-level shared lock. Other ranges are inserted one by
+   * one.
+   */
+
+  template<
+    typename GroupAccessMode,typename InputIterator,typename F1,typename F2
+  >
+  std::size_t bulk_emplace_and_visit_impl(
+    GroupAccessMode access_mode,InputIterator first,InputIterator last,
+    F1&& f1,F2&& f2,std::size_t& n)
+  {
+    return bulk_emplace_and_visit_impl(
+      access_mode,first,last,std::forward<F1>(f1),std::forward<F2>(f2),n,
+      is_bulk_emplaceable_iterator<InputIterator>{});
+  }
+
+  template<
+    typename GroupAccessMode,typename InputIterator,typename F1,typename F2
+  >
+  std::size_t bulk_emplace_and_visit_impl(
+    GroupAccessMode access_mode,InputIterator first,InputIterator last,
+    F1&& f1,F2&& f2,std::size_t& n,std::false_type /* one by one */)
+  {
+    std::size_t res=0;
+    for(n=0;first!=last;++first,++n){
+      auto&& x=*first;
+      auto&& f=bind_value_visitor(f2,std::forward<decltype(x)>(x));
+      if(emplace_and_visit_value(
+        access_mode,f1,f,std::forward<decltype(x)>(x)))++res;
+    }
+    return res;
+  }
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename Value>
+  BOOST_FORCEINLINE bool emplace_and_visit_value(
+    GroupAccessMode access_mode,F1& f1,F2& f2,Value&& x)
+  {
+    return emplace_and_visit_value(
+      access_mode,f1,f2,std::forward<Value>(x),
+      std::integral_constant<
+        bool,
+        detail::is_similar_to_any<Value,value_type,init_type>::value
+      >{});
+  }
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename Value>
+  BOOST_FORCEINLINE bool emplace_and_visit_value(
+    GroupAccessMode access_mode,F1& f1,F2& f2,Value&& x,
+    std::true_type /* no need to construct first */)
+  {
+    return emplace_and_visit_impl(access_mode,f1,f2,std::forward<Value>(x));
+  }
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename Value>
+  BOOST_FORCEINLINE bool emplace_and_visit_value(
+    GroupAccessMode access_mode,F1& f1,F2& f2,Value&& x,std::false_type)
+  {
+    return construct_and_emplace_and_visit(
+      access_mode,f1,f2,std::forward<Value>(x));
+  }
+
+  template<
+    typename GroupAccessMode,typename FwdIterator,typename F1,typename F2
+  >
+  std::size_t bulk_emplace_and_visit_impl(
+    GroupAccessMode access_mode,FwdIterator first,FwdIterator last,
+    F1&& f1,F2&& f2,std::size_t& n,std::true_type /* bulk */)
+  {
+    std::size_t res=0,
+                m=static_cast<std::size_t>(std::distance(first,last));
+    n=m;
+    while(m){
+      auto k=m<2*bulk_visit_size?m:bulk_visit_size;
+      res+=bulk_emplace_and_visit_chunk(access_mode,first,k,f1,f2);
+      m-=k;
+      std::advance(
+        first,
+        static_cast<
+          typename std::iterator_traits<FwdIterator>::difference_type>(k));
+    }
+    return res;
+  }
+
+  template<
+    typename GroupAccessMode,typename FwdIterator,typename F1,typename F2
+  >
+  BOOST_FORCEINLINE std::size_t bulk_emplace_and_visit_chunk(
+    GroupAccessMode access_mode,FwdIterator first,std::size_t m,
+    F1& f1,F2& f2)
+  {
+    BOOST_ASSERT(m<2*bulk_visit_size);
+
+    std::size_t res=0,i=0,
+                hashes[2*bulk_visit_size-1],
+                positions[2*bulk_visit_size-1];
+
+    for(;;){
+      {
+        auto lck=shared_access();
+
+        /* Hashes and positions are (re)calculated under the lock as
+         * the table may have been swapped or rehashed meanwhile.
+         */
+
+        auto it=first;
+        for(auto j=i;j<m;++j,++it){
+          auto hash=hashes[j]=this->hash_for(this->key_from(*it));
+          auto pos=positions[j]=this->position_for(hash);
+          BOOST_UNORDERED_PREFETCH(this->arrays.groups()+pos);
+          BOOST_UNORDERED_PREFETCH(this->arrays.group_accesses()+pos);
+        }
+
+        for(auto j=i;j<m;++j){
+          auto pos=positions[j];
+          auto mask=(this->arrays.groups()+pos)->match(hashes[j]);
+          if(mask){
+            BOOST_UNORDERED_PREFETCH(
+              this->arrays.elements()+pos*N+unchecked_countr_zero(mask));
+          }
+        }
+
+        for(;i<m;++i,++first){
+          auto&& x=*first;
+          int r=unprotected_norehash_emplace_and_visit_at(
+            access_mode,positions[i],hashes[i],f1,
+            bind_value_visitor(f2,std::forward<decltype(x)>(x)),
+            std::forward<decltype(x)>(x));
+          if(BOOST_UNLIKELY(r<0)){
+            if(fixed_capacity)continue;
+            break;
+          }
+          res+=static_cast<std::size_t>(r);
+        }
+        preallocate_if_due();
+        if(i==m)return res;
       }
       rehash_if_full();
     }
@@ -1622,6 +3685,7 @@ private:
     if(BOOST_LIKELY(this->size_ctrl.size<this->size_ctrl.ml)){
       this->unchecked_emplace_at(pos0,hash,std::forward<Args>(args)...);
     }
+    else if(fixed_capacity)return false;
     else{
       this->unchecked_emplace_with_rehash(hash,std::forward<Args>(args)...);
     }
@@ -1683,10 +3747,20 @@ private:
   BOOST_FORCEINLINE int
   unprotected_norehash_emplace_and_visit(
     GroupAccessMode access_mode,F1&& f1,F2&& f2,Args&&... args)
+  {
+    auto hash=this->hash_for(this->key_from(std::forward<Args>(args)...));
+    return unprotected_norehash_emplace_and_visit_at(
+      access_mode,this->position_for(hash),hash,
+      std::forward<F1>(f1),std::forward<F2>(f2),std::forward<Args>(args)...);
+  }
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename... Args>
+  BOOST_FORCEINLINE int
+  unprotected_norehash_emplace_and_visit_at(
+    GroupAccessMode access_mode,std::size_t pos0,std::size_t hash,
+    F1&& f1,F2&& f2,Args&&... args)
   {
     const auto &k=this->key_from(std::forward<Args>(args)...);
-    auto        hash=this->hash_for(k);
-    auto        pos0=this->position_for(hash);
 
     for(;;){
     startover:
@@ -1706,6 +3780,7 @@ private:
             reserve_slot rslot{pg,n,hash};
             if(BOOST_UNLIKELY(insert_counter(pos0)++!=counter)){
               /* other thread inserted from pos0, need to start over */
+              add_insertion_restart_stats();
               goto startover;
             }
             auto p=this->arrays.elements()+pos*N+n;
@@ -1723,11 +3798,324 @@ private:
     }
   }
 
+  /* Same as unprotected_norehash_emplace_and_visit_at, but group locking is
+   * non-blocking, and so is waiting for a concurrent insertion from pos0 to
+   * be looked up (would_block). Insertion into a full table is reported as
+   * would_block (rehashing is a blocking operation) except in fixed-capacity
+   * mode, where it is reported as full.
+   */
+
+  template<typename GroupAccessMode,typename F,typename... Args>
+  BOOST_FORCEINLINE nonblocking_result unprotected_nonblocking_emplace_or_visit(
+    GroupAccessMode access_mode,F&& f,Args&&... args)
+  {
+    const auto &k=this->key_from(std::forward<Args>(args)...);
+    auto        hash=this->hash_for(k);
+    auto        pos0=this->position_for(hash);
+
+    boost::uint32_t counter=insert_counter(pos0);
+    auto res=unprotected_nonblocking_internal_visit(
+      access_mode,k,pos0,hash,
+      [&](group_type*,unsigned int,element_type* p)
+        {visit_element(access_mode,f,p);});
+    if(res!=nonblocking_result::not_found)return res;
+
+    reserve_size rsize(*this);
+    if(BOOST_UNLIKELY(!rsize.succeeded())){
+      return fixed_capacity?
+        nonblocking_result::full:nonblocking_result::would_block;
+    }
+    for(prober pb(pos0);;pb.next(this->arrays.groups_size_mask)){
+      auto pos=pb.get();
+      auto pg=this->arrays.groups()+pos;
+      auto lck=try_access(group_exclusive{},pos);
+      if(BOOST_UNLIKELY(!lck.owns_lock())){
+        return nonblocking_result::would_block;
+      }
+      auto mask=pg->match_available();
+      if(BOOST_LIKELY(mask!=0)){
+        auto n=unchecked_countr_zero(mask);
+        reserve_slot rslot{pg,n,hash};
+        if(BOOST_UNLIKELY(insert_counter(pos0)++!=counter)){
+          /* other thread inserted from pos0, the lookup is to be redone */
+          add_insertion_restart_stats();
+          return nonblocking_result::would_block;
+        }
+        auto p=this->arrays.elements()+pos*N+n;
+        this->construct_element(p,std::forward<Args>(args)...);
+        rslot.commit();
+        rsize.commit();
+        BOOST_UNORDERED_ADD_STATS(this->cstats.insertion,(pb.length()));
+        return nonblocking_result::inserted;
+      }
+      pg->mark_overflow(hash);
+    }
+  }
+
   void rehash_if_full()
   {
+    {
+      /* not a stall if another thread has already completed the rehash */
+      auto lck=try_shared_access();
+      if(acquired(lck)&&this->size_ctrl.size<this->size_ctrl.ml)return;
+    }
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+    contention_stats_timer tmr{
+      ccstats.num_rehash_stalls,ccstats.rehash_stall_time};
+#endif
+
+    {
+      /* Threads finding the table full while another thread rehashes it
+       * help with the rehash (see shared_access) and then retry insertion.
+       */
+      auto lck=shared_access();
+      if(this->size_ctrl.size<this->size_ctrl.ml)return;
+    }
+
     auto lck=exclusive_access();
     if(this->size_ctrl.size==this->size_ctrl.ml){
-      this->unchecked_rehash_for_growth();
+      /* same criterion as table_core::nosize_transfer_element */
+      cooperative_rehash_for_growth(std::integral_constant<
+        bool,
+        std::is_nothrow_move_constructible<init_type>::value||
+        !std::is_same<element_type,value_type>::value||
+        !std::is_copy_constructible<element_type>::value>{});
+    }
+  }
+
+  /* Preallocation machinery */
+
+  enum preallocation_state:unsigned char
+  {
+    prealloc_none,prealloc_busy,prealloc_ready,prealloc_failed
+  };
+
+  /* Invoked under shared access after insertion. */
+
+  BOOST_FORCEINLINE void preallocate_if_due()
+  {
+    auto t=prealloc_threshold.load(std::memory_order_relaxed);
+    if(BOOST_UNLIKELY(t<1.0f))preallocate_if_due(t);
+  }
+
+  BOOST_NOINLINE void preallocate_if_due(float t)
+  {
+    /* a fixed-capacity table may have got a threshold before a swap */
+    std::size_t ml=this->size_ctrl.ml;
+    if(fixed_capacity||
+       static_cast<float>(this->size_ctrl.size)<t*static_cast<float>(ml)||
+       prealloc_state.load(std::memory_order_relaxed)!=prealloc_none)return;
+
+    unsigned char s=prealloc_none;
+    if(!prealloc_state.compare_exchange_strong(s,prealloc_busy))return;
+
+    /* The exclusive section of rehashing can't start until we release shared
+     * access, so it'll find the arrays ready.
+     */
+
+    BOOST_TRY{
+      preallocated=this->new_arrays(this->capacity_for_growth(ml));
+      prefault(preallocated);
+      prealloc_state.store(prealloc_ready);
+    }
+    BOOST_CATCH(...){
+      /* not retried until next rehash */
+      prealloc_state.store(prealloc_failed);
+    }
+    BOOST_CATCH_END
+  }
+
+  static void prefault(const arrays_type& arrays_)noexcept
+  {
+    /* group metadata and group accesses are already initialized */
+    static constexpr std::size_t page_size=4096;
+
+    auto p=reinterpret_cast<volatile unsigned char*>(arrays_.elements());
+    auto n=(arrays_.groups_size_mask+1)*N*sizeof(element_type);
+    for(std::size_t i=0;i<n;i+=page_size)p[i]=0;
+  }
+
+  /* Invoked under exclusive access. */
+
+  arrays_type new_arrays_for_growth_or_preallocated()
+  {
+    if(prealloc_state.load(std::memory_order_relaxed)==prealloc_ready&&
+       preallocated.groups_size_mask+1==
+         (this->capacity_for(this->capacity_for_growth(this->size_ctrl.size))+1)/N){
+      prealloc_state.store(prealloc_none,std::memory_order_relaxed);
+      return preallocated;
+    }
+    discard_preallocated_arrays();
+    return this->new_arrays_for_growth();
+  }
+
+  void discard_preallocated_arrays()noexcept
+  {
+    if(prealloc_state.load(std::memory_order_relaxed)==prealloc_ready){
+      this->delete_arrays(preallocated);
+    }
+    prealloc_state.store(prealloc_none,std::memory_order_relaxed);
+  }
+
+  /* Cooperative rehashing machinery */
+
+  static constexpr std::size_t rehash_chunk_size=64; /* groups */
+  static constexpr std::size_t min_cooperative_rehash_size=
+    4*rehash_chunk_size;
+
+  struct cooperative_rehash_type
+  {
+    const arrays_type*       new_arrays=nullptr;
+    std::atomic<bool>        in_progress{false};
+    std::atomic<std::size_t> num_helpers{0};
+    std::atomic<std::size_t> next{0}; /* first group of next chunk */
+    std::atomic<std::size_t> num_lost{0};
+    std::atomic<bool>        failed{false};
+    std::exception_ptr       exception;
+  };
+
+  /* Invoked under exclusive access. */
+
+  void cooperative_rehash_for_growth(std::false_type /* copy */)
+  {
+    auto new_arrays_=new_arrays_for_growth_or_preallocated();
+    this->unchecked_rehash(new_arrays_);
+  }
+
+  void cooperative_rehash_for_growth(std::true_type /* move */)
+  {
+    auto new_arrays_=new_arrays_for_growth_or_preallocated();
+    if(this->arrays.groups_size_mask+1<min_cooperative_rehash_size){
+      this->unchecked_rehash(new_arrays_);
+      return;
+    }
+
+    auto  rn=this->make_rehash_notifier(new_arrays_);
+    auto& r=crehash;
+    r.new_arrays=&new_arrays_;
+    r.next.store(0,std::memory_order_relaxed);
+    r.in_progress.store(true);
+    cooperative_rehash_transfer();
+    r.in_progress.store(false);
+    while(r.num_helpers.load()!=0)boost::core::sp_thread_yield();
+
+    /* all elements moved to new_arrays_ save for those whose transfer threw,
+     * which are destroyed: new_arrays_ is used anyway, so the rehash is
+     * reported as completed along with the number of elements lost
+     */
+    auto num_lost=r.num_lost.exchange(0,std::memory_order_relaxed);
+    this->delete_arrays(this->arrays);
+    this->arrays=new_arrays_;
+    this->size_ctrl.ml=this->initial_max_load();
+    this->size_ctrl.size-=num_lost;
+    r.new_arrays=nullptr;
+    rn.notify_completion(num_lost);
+    if(r.failed.exchange(false,std::memory_order_relaxed)){
+      auto ep=r.exception;
+      r.exception=nullptr;
+      std::rethrow_exception(ep);
+    }
+  }
+
+  /* Old groups are transferred in chunks claimed by the rehashing thread and
+   * by helpers, with insertion into the new arrays protected by their group
+   * locks.
+   */
+
+  /* Returns false if there were no chunks left to transfer. */
+
+  bool cooperative_rehash_transfer()noexcept
+  {
+    auto&       r=crehash;
+    const auto& new_arrays_=*r.new_arrays;
+    auto        pg0=this->arrays.groups();
+    auto        num_groups=this->arrays.groups_size_mask+1;
+    bool        res=false;
+    for(;;res=true){
+      auto first=r.next.fetch_add(
+        rehash_chunk_size,std::memory_order_relaxed);
+      if(first>=num_groups)return res;
+      auto last=(std::min)(first+rehash_chunk_size,num_groups);
+      for(auto pos=first;pos<last;++pos){
+        auto pg=pg0+pos;
+        auto p=this->arrays.elements()+pos*N;
+        auto mask=this->match_really_occupied(pg,pg0+num_groups);
+        for(;mask;mask&=mask-1){
+          auto n=unchecked_countr_zero(mask);
+          BOOST_TRY{
+            cooperative_transfer_element(p+n,new_arrays_);
+          }
+          BOOST_CATCH(...){
+            r.num_lost.fetch_add(1,std::memory_order_relaxed);
+            if(!r.failed.exchange(true,std::memory_order_relaxed)){
+              r.exception=std::current_exception();
+            }
+          }
+          BOOST_CATCH_END
+        }
+      }
+    }
+  }
+
+  void cooperative_transfer_element(
+    element_type* p,const arrays_type& new_arrays_)
+  {
+    /* p is destroyed even if hashing or move construction throws */
+    typename super::destroy_element_on_exit d{this,p};
+    (void)d; /* unused var warning */
+
+    auto hash=this->hash_for(this->key_from(*p));
+    for(prober pb(this->position_for(hash,new_arrays_));;
+        pb.next(new_arrays_.groups_size_mask)){
+      auto pos=pb.get();
+      auto pg=new_arrays_.groups()+pos;
+      auto lck=new_arrays_.group_accesses()[pos].exclusive_access();
+      auto mask=pg->match_available();
+      if(BOOST_LIKELY(mask!=0)){
+        auto n=unchecked_countr_zero(mask);
+        this->construct_element(
+          new_arrays_.elements()+pos*N+n,type_policy::move(*p));
+        pg->set(n,hash);
+        BOOST_UNORDERED_ADD_STATS(this->cstats.insertion,(pb.length()));
+        return;
+      }
+      pg->mark_overflow(hash);
+    }
+  }
+
+  /* Returns false if there is no rehash work left to help with. */
+
+  bool help_rehash()const noexcept
+  {
+    auto& r=crehash;
+    if(!r.in_progress.load(std::memory_order_relaxed))return false;
+
+    /* the rehashing thread waits for registered helpers before completing */
+    ++r.num_helpers;
+    bool res=
+      r.in_progress.load()&&
+      /* the rehashing thread holds exclusive access on behalf of us */
+      const_cast<concurrent_table*>(this)->cooperative_rehash_transfer();
+    --r.num_helpers;
+    return res;
+  }
+
+  BOOST_NOINLINE void lock_shared_or_help_rehash(mutex_type& m)const noexcept
+  {
+    auto stats=shared_lock_stats();
+    for(unsigned k=0;!m.try_lock_shared();++k){
+      if(help_rehash())continue;
+
+      stats.spin();
+
+      /* same backoff policy as rw_spinlock */
+      k%=1024;
+      if(k<5){
+        for(unsigned i=0;i<(1u<<k);++i)boost::core::sp_thread_pause();
+      }
+      else if(k<1023)boost::core::sp_thread_yield();
+      else boost::core::sp_thread_sleep();
     }
   }
 
@@ -1776,7 +4164,6 @@ private:
     return true;
   }
 
-#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
   template<typename GroupAccessMode,typename ExecutionPolicy,typename F>
   auto for_all_elements(
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F f)const
@@ -1795,7 +4182,7 @@ private:
     if(!this->arrays.elements())return;
     auto first=this->arrays.groups(),
          last=first+this->arrays.groups_size_mask+1;
-    std::for_each(std::forward<ExecutionPolicy>(policy),first,last,
+    parallel_for_each(std::forward<ExecutionPolicy>(policy),first,last,
       [&,this](group_type& g){
         auto pos=static_cast<std::size_t>(&g-first);
         auto p=this->arrays.elements()+pos*N;
@@ -1817,7 +4204,7 @@ private:
     if(!this->arrays.elements())return true;
     auto first=this->arrays.groups(),
          last=first+this->arrays.groups_size_mask+1;
-    return std::all_of(std::forward<ExecutionPolicy>(policy),first,last,
+    return parallel_all_of(std::forward<ExecutionPolicy>(policy),first,last,
       [&,this](group_type& g){
         auto pos=static_cast<std::size_t>(&g-first);
         auto p=this->arrays.elements()+pos*N;
@@ -1832,7 +4219,6 @@ private:
       }
     );
   }
-#endif
 
   friend class boost::serialization::access;
 
@@ -1853,7 +4239,7 @@ private:
   template<typename Archive>
   void save(Archive& ar,unsigned int,std::true_type /* set */)const
   {
-    auto                                    lck=exclusive_access();
+    auto                                    lck=read_only_exclusive_access();
     const std::size_t                       s=super::size();
     const serialization_version<value_type> value_version;
 
@@ -1874,7 +4260,8 @@ private:
     using raw_mapped_type=typename std::remove_const<
       typename TypePolicy::mapped_type>::type;
 
-    auto                                         lck=exclusive_access();
+    auto lck=read_only_exclusive_access();
+
     const std::size_t                            s=super::size();
     const serialization_version<raw_key_type>    key_version;
     const serialization_version<raw_mapped_type> mapped_version;
@@ -1972,8 +4359,21 @@ private:
     }
   }
 
-  static std::atomic<std::size_t> thread_counter;
-  mutable multimutex_type         mutexes;
+  static std::atomic<std::size_t>     thread_counter;
+  bool                                fixed_capacity=false;
+  mutable multimutex_type             mutexes;
+  mutable mutex_type                  snapshot_mutex;
+  mutable std::atomic<snapshot_type*> current_snapshot{nullptr};
+  mutable std::atomic<unsigned char>  qstate{quiescence_off};
+  epoch_domain*                       epochs=nullptr;
+  mutable cooperative_rehash_type     crehash;
+  std::atomic<float>                  prealloc_threshold{1.0f};
+  std::atomic<unsigned char>          prealloc_state{prealloc_none};
+  arrays_type                         preallocated{
+                                        {0,0,nullptr,nullptr},nullptr};
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  mutable concurrent_table_cumulative_contention_stats ccstats;
+#endif
 };
 
 template<typename T,typename H,typename P,typename A>
@@ -27,9 +27,12 @@
 #include <boost/unordered/detail/allocator_constructed.hpp>
 #include <boost/unordered/detail/narrow_cast.hpp>
 #include <boost/unordered/detail/mulx.hpp>
+#include <boost/unordered/detail/rehash_notifier.hpp>
 #include <boost/unordered/detail/static_assert.hpp>
 #include <boost/unordered/detail/type_traits.hpp>
 #include <boost/unordered/detail/unordered_printers.hpp>
+#include <boost/unordered/memory_usage.hpp>
+#include <array>
 #include <climits>
 #include <cmath>
 #include <cstddef>
@@ -1099,6 +1102,21 @@ struct table_arrays
     }
   }
 
+  std::size_t allocated_bytes()const noexcept
+  {
+    return elements()?
+      buffer_size(groups_size_mask+1)*sizeof(value_type):0;
+  }
+
+  void add_memory_usage(memory_usage_info& res)const noexcept
+  {
+    if(elements()){
+      auto groups_bytes=(groups_size_mask+1)*sizeof(group_type);
+      res.group_metadata+=groups_bytes;
+      res.element_slots+=allocated_bytes()-groups_bytes; /* incl. padding */
+    }
+  }
+
   /* combined space for elements and groups measured in sizeof(value_type)s */
 
   static std::size_t buffer_size(std::size_t groups_size)
@@ -1138,6 +1156,19 @@ struct table_arrays
   value_type_pointer elements_;
 };
 
+/* layout_stats support */
+
+struct table_core_layout_stats
+{
+  std::size_t                num_groups;
+  std::array<std::size_t,16> group_occupancy;
+  std::size_t                num_overflowed_groups;
+  double                     overflowed_group_ratio;
+  std::size_t                max_probe_length;
+  double                     average_probe_length;
+  std::size_t                num_reduced_hash_collisions;
+};
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
 /* stats support */
 
@@ -1166,6 +1197,7 @@ struct table_core_stats
   table_core_insertion_stats insertion;
   table_core_lookup_stats    successful_lookup,
                              unsuccessful_lookup;
+  sequence_histogram         group_occupancy;
 };
 
 #define BOOST_UNORDERED_ADD_STATS(stats,args) stats.add args
@@ -1456,6 +1488,8 @@ public:
   using locator=table_locator<group_type,element_type>;
   using arrays_holder_type=arrays_holder<arrays_type,Allocator>;
 
+  using layout_stats_type=table_core_layout_stats;
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   using cumulative_stats=table_core_cumulative_stats;
   using stats=table_core_stats;
@@ -1835,6 +1869,71 @@ public:
     rehash(std::size_t(std::ceil(float(n)/mlf)));
   }
 
+  /* dynamic memory held, computed from the current layout */
+
+  memory_usage_info memory_usage()const noexcept
+  {
+    constexpr std::size_t node_size=
+      std::is_same<element_type,value_type>::value?0:sizeof(value_type);
+
+    memory_usage_info res{};
+    arrays.add_memory_usage(res);
+    res.nodes=size()*node_size;
+    res.total=res.group_metadata+res.element_slots+res.nodes;
+    return res;
+  }
+
+  /* Single scan of the group array. Keys are rehashed to determine the probe
+   * length of each element, i.e. the number of groups visited from its
+   * initial position to the group where it is located.
+   */
+
+  layout_stats_type layout_stats()const
+  {
+    BOOST_UNORDERED_STATIC_ASSERT(N<16);
+
+    layout_stats_type res{};
+    if(!arrays.elements())return res;
+
+    std::size_t num_elements=0,total_probe_length=0;
+    auto        pg0=arrays.groups(),last=pg0+arrays.groups_size_mask+1;
+    auto        p=arrays.elements();
+    for(auto pg=pg0;pg!=last;++pg,p+=N){
+      auto occupied=match_really_occupied(pg,last);
+      ++res.group_occupancy[
+        static_cast<std::size_t>(boost::core::popcount(
+          static_cast<unsigned int>(occupied)))];
+      for(std::size_t i=0;i<8;++i){
+        if(!pg->is_not_overflowed(i)){
+          ++res.num_overflowed_groups;
+          break;
+        }
+      }
+
+      for(auto mask=occupied;mask;mask&=mask-1){
+        auto hash=hash_for(key_from(p[unchecked_countr_zero(mask)]));
+        if(boost::core::popcount(
+             static_cast<unsigned int>(pg->match(hash)&occupied))>1){
+          ++res.num_reduced_hash_collisions;
+        }
+
+        prober pb(position_for(hash));
+        while(pg0+pb.get()!=pg)pb.next(arrays.groups_size_mask);
+        ++num_elements;
+        total_probe_length+=pb.length();
+        if(pb.length()>res.max_probe_length)res.max_probe_length=pb.length();
+      }
+    }
+    res.num_groups=arrays.groups_size_mask+1;
+    res.overflowed_group_ratio=
+      double(res.num_overflowed_groups)/double(res.num_groups);
+    if(num_elements){
+      res.average_probe_length=
+        double(total_probe_length)/double(num_elements);
+    }
+    return res;
+  }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   stats get_stats()const
   {
@@ -1856,9 +1955,28 @@ public:
         unsuccessful_lookup.sequence_summary[0],
         unsuccessful_lookup.sequence_summary[1]
       },
+      group_occupancy()
     };
   }
 
+  /* number of groups per count of occupied slots, calculated on the spot */
+
+  sequence_histogram group_occupancy()const noexcept
+  {
+    BOOST_UNORDERED_STATIC_ASSERT(N<sequence_histogram::num_exact_buckets);
+
+    sequence_histogram res{};
+    if(arrays.elements()){
+      for(auto pg=arrays.groups(),last=pg+arrays.groups_size_mask+1;
+          pg!=last;++pg){
+        auto n=boost::core::popcount(
+          static_cast<unsigned int>(match_really_occupied(pg,last)));
+        ++res.counts[static_cast<std::size_t>(n)];
+      }
+    }
+    return res;
+  }
+
   void reset_stats()noexcept
   {
     cstats.insertion.reset();
@@ -2012,9 +2130,11 @@ public:
 
       if(n>capacity()){
         auto new_arrays_=new_arrays(n);
+        auto rn=make_rehash_notifier(new_arrays_);
         delete_arrays(arrays);
         arrays=new_arrays_;
         size_ctrl.ml=initial_max_load();
+        rn.notify_completion();
       }
     }
   }
@@ -2088,6 +2208,11 @@ private:
   >
   friend class table_core;
 
+  /* concurrent_table reuses array allocation and rehashing internals */
+
+  template<typename,typename,typename,typename>
+  friend class concurrent_table;
+
   using hash_base=empty_value<Hash,0>;
   using pred_base=empty_value<Pred,1>;
   using allocator_base=empty_value<Allocator,2>;
@@ -2128,8 +2253,12 @@ private:
      * probability of an element having caused overflow; P has been measured as
      * ~0.162 under ideal conditions, yielding F ~ 0.0165 ~ 1/61.
      */
-    return new_arrays(std::size_t(
-      std::ceil(static_cast<float>(size()+size()/61+1)/mlf)));
+    return new_arrays(capacity_for_growth(size()));
+  }
+
+  static std::size_t capacity_for_growth(std::size_t n)
+  {
+    return std::size_t(std::ceil(static_cast<float>(n+n/61+1)/mlf));
   }
 
   void delete_arrays(arrays_type& arrays_)noexcept
@@ -2137,6 +2266,16 @@ private:
     arrays_type::delete_(typename arrays_type::allocator_type(al()),arrays_);
   }
 
+  /* to be invoked right before moving to new_arrays_ */
+
+  default_rehash_notifier make_rehash_notifier(
+    const arrays_type& new_arrays_)const noexcept
+  {
+    return {
+      this,capacity(),(new_arrays_.groups_size_mask+1)*N-1,size(),
+      new_arrays_.allocated_bytes()};
+  }
+
   arrays_holder_type make_arrays(std::size_t n)const
   {
     return {new_arrays(n),al()};
@@ -2286,6 +2425,7 @@ private:
 
   BOOST_NOINLINE void unchecked_rehash(arrays_type& new_arrays_)
   {
+    auto        rn=make_rehash_notifier(new_arrays_);
     std::size_t num_destroyed=0;
     BOOST_TRY{
       for_all_elements([&,this](element_type* p){
@@ -2319,6 +2459,7 @@ private:
     delete_arrays(arrays);
     arrays=new_arrays_;
     size_ctrl.ml=initial_max_load();
+    rn.notify_completion();
   }
 
   template<typename Value>
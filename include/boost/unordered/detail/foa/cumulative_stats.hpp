@@ -10,8 +10,12 @@
 #define BOOST_UNORDERED_DETAIL_FOA_CUMULATIVE_STATS_HPP
 
 #include <array>
+#include <boost/assert.hpp>
 #include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/mp11/tuple.hpp>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 
@@ -20,20 +24,101 @@
 #include <mutex>
 #endif
 
+#if !defined(BOOST_UNORDERED_STATS_SAMPLING_PERIOD)
+#define BOOST_UNORDERED_STATS_SAMPLING_PERIOD 1
+#endif
+
 namespace boost{
 namespace unordered{
 namespace detail{
 namespace foa{
 
+inline std::atomic<std::size_t>& stats_sampling_period_storage()noexcept
+{
+  static std::atomic<std::size_t> period{
+    BOOST_UNORDERED_STATS_SAMPLING_PERIOD};
+  return period;
+}
+
+/* Decides whether the current operation is recorded, returning the number
+ * of operations the sample stands for (0 if not sampled). One in every
+ * stats_sampling_period() operations is sampled on average, using a per-thread
+ * countdown so that unsampled operations don't write any shared data. The
+ * distance between samples is randomized lest it synchronize with some
+ * periodic pattern of operations (for instance, unsuccessful lookup followed
+ * by insertion).
+ */
+
+inline std::size_t sample_stats()noexcept
+{
+  auto period=stats_sampling_period_storage().load(std::memory_order_relaxed);
+  if(period<=1)return 1;
+
+  static thread_local std::size_t     countdown=0;
+  static thread_local boost::uint64_t rng=0x9E3779B97F4A7C15ull;
+  if(countdown>1){
+    --countdown;
+    return 0;
+  }
+  rng=rng*6364136223846793005ull+1442695040888963407ull; /* LCG, Knuth */
+  countdown=1+static_cast<std::size_t>((rng>>33)%(2*period-1));
+  return period;
+}
+
+/* Fixed-bucket histogram of a sequence of nonnegative integral values.
+ * Values 0 to 15 have a bucket each; larger values are counted in buckets
+ * [2^k,2^(k+1)), the last one also taking all values beyond. This is exact
+ * for usual probe lengths and comparison counts while still capturing the
+ * long tails produced by clustered hash values.
+ */
+
+struct sequence_histogram
+{
+  static constexpr std::size_t num_exact_buckets=16;
+  static constexpr std::size_t size=num_exact_buckets+8;
+
+  static std::size_t bucket_for(std::size_t x)noexcept
+  {
+    if(x<num_exact_buckets)return x;
+    auto i=num_exact_buckets-5+static_cast<std::size_t>(core::bit_width(x));
+    return i<size?i:size-1;
+  }
+
+  static std::size_t lower_bound(std::size_t i)noexcept
+  {
+    BOOST_ASSERT(i<size);
+    return i<num_exact_buckets?i:std::size_t(1)<<(i-num_exact_buckets+4);
+  }
+
+  /* lower bound of the bucket where the p-quantile lies */
+
+  std::size_t percentile(double p)const noexcept
+  {
+    std::size_t total=0;
+    for(auto c:counts)total+=c;
+
+    auto        target=p*static_cast<double>(total);
+    std::size_t acc=0;
+    for(std::size_t i=0;i<size;++i){
+      acc+=counts[i];
+      if(acc!=0&&static_cast<double>(acc)>=target)return lower_bound(i);
+    }
+    return 0;
+  }
+
+  std::array<std::size_t,size> counts;
+};
+
 /* Cumulative one-pass calculation of the average, variance and deviation of
- * running sequences.
+ * running sequences, plus their histograms.
  */
 
 struct sequence_stats_data
 {
-  double m=0.0;
-  double m_prior=0.0;
-  double s=0.0;
+  double                                           m=0.0;
+  double                                           m_prior=0.0;
+  double                                           s=0.0;
+  std::array<std::size_t,sequence_histogram::size> counts{};
 };
 
 struct welfords_algorithm /* 0-based */
@@ -45,22 +130,38 @@ struct welfords_algorithm /* 0-based */
       noexcept(static_cast<double>(x)),
       "Argument conversion to double must not throw.");
 
+    /* sample stands for w equal values */
+    auto dw=static_cast<double>(w);
     d.m_prior=d.m;
-    d.m+=(static_cast<double>(x)-d.m)/static_cast<double>(n);
-    d.s+=(n!=1)*
+    d.m+=(static_cast<double>(x)-d.m)*dw/static_cast<double>(n);
+    d.s+=(n!=w)*dw*
       (static_cast<double>(x)-d.m_prior)*(static_cast<double>(x)-d.m);
 
     return 0; /* mp11::tuple_transform requires that return type not be void */
   }
 
   std::size_t n;
+  std::size_t w;
+};
+
+struct histogram_update
+{
+  template<typename T>
+  int operator()(T&& x,sequence_stats_data& d)const noexcept
+  {
+    d.counts[sequence_histogram::bucket_for(static_cast<std::size_t>(x))]+=w;
+    return 0;
+  }
+
+  std::size_t w;
 };
 
 struct sequence_stats_summary
 {
-  double average;
-  double variance;
-  double deviation;
+  double             average;
+  double             variance;
+  double             deviation;
+  sequence_histogram histogram;
 };
 
 /* Stats calculated jointly for N same-sized sequences to save the space
@@ -81,18 +182,26 @@ public:
   
   template<typename... Ts>
   void add(Ts&&... xs)noexcept
+  {
+    auto w=sample_stats();
+    if(w)add_sample(w,std::forward<Ts>(xs)...);
+  }
+
+  /* sample standing for w operations */
+
+  template<typename... Ts>
+  void add_sample(std::size_t w,Ts&&... xs)noexcept
   {
     static_assert(
       sizeof...(Ts)==N,"A sample must be provided for each sequence.");
 
-    if(BOOST_UNLIKELY(++n==0)){ /* wraparound */
+    if(BOOST_UNLIKELY((n+=w)<w)){ /* wraparound */
       reset();
-      n=1;
+      n=w;
     }
-    mp11::tuple_transform(
-      welfords_algorithm{n},
-      std::forward_as_tuple(std::forward<Ts>(xs)...),
-      data);
+    auto sample=std::forward_as_tuple(std::forward<Ts>(xs)...);
+    mp11::tuple_transform(welfords_algorithm{n,w},sample,data);
+    mp11::tuple_transform(histogram_update{w},sample,data);
   }
   
   summary get_summary()const noexcept
@@ -103,7 +212,7 @@ public:
       double average=data[i].m,
              variance=n!=0?data[i].s/static_cast<double>(n):0.0, /* biased */
              deviation=std::sqrt(variance);
-      res.sequence_summary[i]={average,variance,deviation};
+      res.sequence_summary[i]={average,variance,deviation,{data[i].counts}};
     }
     return res;
   }
@@ -146,8 +255,11 @@ public:
   template<typename... Ts>
   void add(Ts&&... xs)noexcept
   {
-    lock_guard lck{mut};
-    super::add(std::forward<Ts>(xs)...);
+    auto w=sample_stats();
+    if(w){
+      lock_guard lck{mut};
+      super::add_sample(w,std::forward<Ts>(xs)...);
+    }
   }
   
   summary get_summary()const noexcept
@@ -171,6 +283,24 @@ using concurrent_cumulative_stats=cumulative_stats<N>;
 
 } /* namespace foa */
 } /* namespace detail */
+
+/* Global setting: one in every n operations is recorded in container stats
+ * (n==0 is taken as n==1).
+ */
+
+inline std::size_t stats_sampling_period()noexcept
+{
+  auto n=detail::foa::stats_sampling_period_storage().load(
+    std::memory_order_relaxed);
+  return n?n:1;
+}
+
+inline void stats_sampling_period(std::size_t n)noexcept
+{
+  detail::foa::stats_sampling_period_storage().store(
+    n,std::memory_order_relaxed);
+}
+
 } /* namespace unordered */
 } /* namespace boost */
 
@@ -0,0 +1,218 @@
+/* Lock-free container-level access for fixed-capacity concurrent tables.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_FOA_QUIESCENCE_HPP
+#define BOOST_UNORDERED_DETAIL_FOA_QUIESCENCE_HPP
+
+#include <atomic>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/core/yield_primitives.hpp>
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)&&!defined(BOOST_UNORDERED_DISABLE_MEMBARRIER)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__NR_membarrier)
+#define BOOST_UNORDERED_HAS_MEMBARRIER
+#endif
+#endif
+
+namespace boost{
+namespace unordered{
+namespace detail{
+namespace foa{
+
+/* A thread accessing a table announces so by storing the table's address
+ * in its quiescence record, a per-thread structure linked into a
+ * process-wide registry, and then checks that the table is not being
+ * quiesced. A thread requiring exclusive access marks the table as
+ * quiescing and waits until no record announces the table. Records are
+ * written by their owning thread only, so the announcing side does no
+ * atomic read-modify-write operation and touches no shared cache line.
+ *
+ * Store-load ordering between the announcement and the check (and between
+ * the marking and the scan of records on the exclusive side) is provided by
+ * an asymmetric pair of barriers: where a process-wide barrier is available
+ * (membarrier(2) on Linux), the exclusive side issues it and the announcing
+ * side need only prevent compiler reordering; otherwise, both sides issue a
+ * sequentially consistent fence.
+ *
+ * Records are never deallocated: they are released on thread exit and
+ * reused by new threads. A thread can announce up to max_depth tables at a
+ * time (accessing a table from within a visitation function on another).
+ */
+
+#if defined(BOOST_UNORDERED_HAS_MEMBARRIER)
+inline bool register_process_wide_barrier()noexcept
+{
+  long cmds=syscall(__NR_membarrier,MEMBARRIER_CMD_QUERY,0);
+  return
+    cmds>=0&&(cmds&MEMBARRIER_CMD_PRIVATE_EXPEDITED)&&
+    syscall(__NR_membarrier,MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED,0)==0;
+}
+
+inline bool has_process_wide_barrier()noexcept
+{
+  static const bool res=register_process_wide_barrier();
+  return res;
+}
+#else
+inline bool has_process_wide_barrier()noexcept{return false;}
+#endif
+
+inline void light_barrier()noexcept
+{
+  if(has_process_wide_barrier()){
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  }
+  else std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void heavy_barrier()noexcept
+{
+#if defined(BOOST_UNORDERED_HAS_MEMBARRIER)
+  if(has_process_wide_barrier()&&
+     syscall(__NR_membarrier,MEMBARRIER_CMD_PRIVATE_EXPEDITED,0)==0){
+    return;
+  }
+#endif
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+struct quiescence_record
+{
+  static constexpr std::size_t max_depth=4;
+
+  quiescence_record()noexcept
+  {
+    for(auto& t:tables)t.store(nullptr,std::memory_order_relaxed);
+  }
+
+  /* owning thread only */
+
+  bool announce(const void* t)noexcept
+  {
+    if(depth==max_depth)return false;
+    tables[depth++].store(t,std::memory_order_relaxed);
+    light_barrier();
+    return true;
+  }
+
+  void withdraw(const void* t)noexcept
+  {
+    BOOST_ASSERT(depth>0&&tables[depth-1].load()==t);
+    (void)t;
+    tables[--depth].store(nullptr,std::memory_order_release);
+  }
+
+  /* exclusive side, after heavy_barrier() */
+
+  void wait_for_withdrawal(const void* t)const noexcept
+  {
+    for(const auto& at:tables){
+      while(at.load(std::memory_order_acquire)==t){
+        boost::core::sp_thread_yield();
+      }
+    }
+  }
+
+  /* padding to avoid false sharing with sorrounding data */
+
+  unsigned char            pad0_[64];
+  std::atomic<const void*> tables[max_depth];
+  std::size_t              depth=0;
+  unsigned char            pad1_[64];
+  std::atomic<bool>        in_use{true};
+  quiescence_record        *next=nullptr;
+};
+
+class quiescence_registry
+{
+public:
+  static quiescence_registry& instance()noexcept
+  {
+    static quiescence_registry r;
+    return r;
+  }
+
+  /* nullptr on thread exit or if a new record can't be allocated */
+
+  static quiescence_record* this_thread_record()noexcept
+  {
+    static thread_local quiescence_record *pr=nullptr;
+    static thread_local bool               acquired=false;
+
+    if(BOOST_LIKELY(pr!=nullptr))return pr;
+    if(acquired)return nullptr;
+    acquired=true;
+    pr=instance().acquire();
+    if(pr){
+      static thread_local releaser r{pr};
+      (void)r;
+    }
+    return pr;
+  }
+
+  /* waits until no record announces t */
+
+  void wait_for_quiescence(const void* t)const noexcept
+  {
+    for(auto pr=head.load(std::memory_order_acquire);pr;pr=pr->next){
+      pr->wait_for_withdrawal(t);
+    }
+  }
+
+private:
+  struct releaser
+  {
+    ~releaser()
+    {
+      BOOST_ASSERT(pr->depth==0);
+      pr->in_use.store(false,std::memory_order_release);
+      pr=nullptr; /* the owner is done with the record */
+    }
+
+    quiescence_record *&pr;
+  };
+
+  quiescence_record* acquire()noexcept
+  {
+    for(auto pr=head.load(std::memory_order_acquire);pr;pr=pr->next){
+      bool in_use=false;
+      if(!pr->in_use.load(std::memory_order_relaxed)&&
+         pr->in_use.compare_exchange_strong(
+           in_use,true,std::memory_order_acq_rel)){
+        return pr;
+      }
+    }
+
+    auto pr=new (std::nothrow) quiescence_record;
+    if(pr){
+      auto next=head.load(std::memory_order_relaxed);
+      do{
+        pr->next=next;
+      }while(!head.compare_exchange_weak(
+        next,pr,std::memory_order_release,std::memory_order_relaxed));
+    }
+    return pr;
+  }
+
+  std::atomic<quiescence_record*> head{nullptr};
+};
+
+} /* namespace foa */
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
@@ -14,6 +14,15 @@ namespace unordered{
 namespace detail{
 namespace foa{
 
+// Receives notification of the contention events found on lock acquisition;
+// rw_spinlock::lock[_shared]() use this one, which does nothing
+
+struct null_lock_stats
+{
+    void spin() noexcept {}
+    void writer_pending() noexcept {}
+};
+
 class rw_spinlock
 {
 private:
@@ -86,6 +95,16 @@ public:
     }
 
     void lock_shared() noexcept
+    {
+        null_lock_stats stats;
+        lock_shared( stats );
+    }
+
+    // Effects: As lock_shared(), invoking stats.spin() each time the thread
+    //          has to wait
+
+    template<class LockStats>
+    void lock_shared( LockStats& stats ) noexcept
     {
         for( unsigned k = 0; ; ++k )
         {
@@ -97,6 +116,7 @@ public:
                 if( state_.compare_exchange_weak( st, newst, std::memory_order_acquire, std::memory_order_relaxed ) ) return;
             }
 
+            stats.spin();
             yield( k );
         }
     }
@@ -132,6 +152,17 @@ public:
     }
 
     void lock() noexcept
+    {
+        null_lock_stats stats;
+        lock( stats );
+    }
+
+    // Effects: As lock(), invoking stats.spin() each time the thread has to
+    //          wait and stats.writer_pending() when it sets the writer pending
+    //          bit
+
+    template<class LockStats>
+    void lock( LockStats& stats ) noexcept
     {
         for( unsigned k = 0; ; ++k )
         {
@@ -157,9 +188,10 @@ public:
                 // locked shared, set writer pending bit
 
                 std::uint32_t newst = st | writer_pending_mask;
-                state_.compare_exchange_weak( st, newst, std::memory_order_relaxed, std::memory_order_relaxed );
+                if( state_.compare_exchange_weak( st, newst, std::memory_order_relaxed, std::memory_order_relaxed ) ) stats.writer_pending();
             }
 
+            stats.spin();
             yield( k );
         }
     }
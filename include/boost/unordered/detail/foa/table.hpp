@@ -18,6 +18,7 @@
 #include <boost/config/workaround.hpp>
 #include <boost/core/serialization.hpp>
 #include <boost/unordered/detail/foa/core.hpp>
+#include <boost/unordered/detail/parallel_algorithms.hpp>
 #include <boost/unordered/detail/serialize_tracked_address.hpp>
 #include <boost/unordered/detail/type_traits.hpp>
 #include <cstddef>
@@ -134,6 +135,8 @@ private:
   template<typename,typename,bool> friend class table_iterator;
   template<typename> friend class table_erase_return_type;
   template<typename,typename,typename,typename> friend class table;
+  template<typename,typename,typename,typename>
+  friend class concurrent_table; /* unsynchronized_view */
 
   table_iterator(group_type* pg,std::size_t n,const table_element_type* ptet):
     pc_{to_pointer<char_pointer>(
@@ -360,6 +363,7 @@ public:
     table_iterator<type_policy,group_type_pointer,false>,
     const_iterator>::type;
   using erase_return_type=table_erase_return_type<iterator>;
+  using layout_stats_type=typename super::layout_stats_type;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   using stats=typename super::stats;
@@ -553,12 +557,48 @@ public:
   using super::max_load;
   using super::rehash;
   using super::reserve;
+  using super::memory_usage;
+  using super::layout_stats;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   using super::get_stats;
   using super::reset_stats;
 #endif
 
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+  template<typename ExecutionPolicy,typename T,typename BinaryOp,typename F>
+  T transform_reduce(
+    ExecutionPolicy&& policy,T init,BinaryOp reduce,F transform)const
+  {
+    using partial=partial_reduction<T>;
+
+    if(!this->arrays.elements())return init;
+    auto first=this->arrays.groups(),
+         last=first+this->arrays.groups_size_mask+1;
+    return std::transform_reduce(
+      std::forward<ExecutionPolicy>(policy),first,last,partial{init},
+      [&](partial x,partial y){
+        return partial::combine(reduce,std::move(x),std::move(y));
+      },
+      [&,this](group_type& g){
+        auto    pos=static_cast<std::size_t>(&g-first);
+        auto    p=this->arrays.elements()+pos*N;
+        auto    mask=super::match_really_occupied(&g,last);
+        partial res{init};
+        while(mask){
+          auto n=unchecked_countr_zero(mask);
+          res.add(
+            reduce,
+            transform(
+              static_cast<const_reference>(type_policy::value_from(p[n]))));
+          mask&=mask-1;
+        }
+        return res;
+      }
+    ).result(reduce,std::move(init));
+  }
+#endif
+
   template<typename Predicate>
   friend std::size_t erase_if(table& x,Predicate& pr)
   {
@@ -19,6 +19,7 @@
 #include <boost/unordered/detail/fca.hpp>
 #include <boost/unordered/detail/opt_storage.hpp>
 #include <boost/unordered/detail/ranges_support.hpp>
+#include <boost/unordered/detail/rehash_notifier.hpp>
 #include <boost/unordered/detail/serialize_tracked_address.hpp>
 #include <boost/unordered/detail/static_assert.hpp>
 #include <boost/unordered/detail/type_traits.hpp>
@@ -45,6 +46,11 @@
 #include <utility>
 #include <tuple> // std::forward_as_tuple
 
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+#include <boost/unordered/detail/foa/cumulative_stats.hpp>
+#include <chrono>
+#endif
+
 namespace boost {
   namespace tuples {
     struct null_type;
@@ -119,6 +125,50 @@ namespace boost {
         }
       } // namespace func
 
+      //////////////////////////////////////////////////////////////////////////
+      // Stats
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+      struct table_cumulative_stats
+      {
+        boost::unordered::detail::foa::cumulative_stats<1> successful_lookup,
+          unsuccessful_lookup;
+        std::size_t num_rehashes = 0;
+        std::chrono::nanoseconds rehash_time{0};
+      };
+
+      struct table_lookup_stats
+      {
+        std::size_t count;
+        boost::unordered::detail::foa::sequence_stats_summary num_comparisons;
+      };
+
+      struct table_rehash_stats
+      {
+        std::size_t count;
+        std::chrono::nanoseconds time;
+      };
+
+      struct table_stats
+      {
+        table_lookup_stats successful_lookup, unsuccessful_lookup;
+        table_rehash_stats rehash;
+        boost::unordered::detail::foa::sequence_histogram bucket_size;
+      };
+
+      // Number of elements compared during a lookup.
+      struct lookup_stats_counter
+      {
+        std::size_t n = 0;
+        void operator++() { ++n; }
+      };
+#else
+      struct lookup_stats_counter
+      {
+        void operator++() {}
+      };
+#endif
+
       //////////////////////////////////////////////////////////////////////////
       // iterator SFINAE
 
@@ -1268,6 +1318,9 @@ namespace boost {
         float mlf_;
         std::size_t max_load_;
         bucket_array_type buckets_;
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+        mutable table_cumulative_stats cstats_;
+#endif
 
       public:
         ////////////////////////////////////////////////////////////////////////
@@ -1275,6 +1328,16 @@ namespace boost {
 
         size_type bucket_count() const { return buckets_.bucket_count(); }
 
+        // Dynamic memory held, computed from the current layout.
+        boost::unordered::memory_usage_info memory_usage() const noexcept
+        {
+          boost::unordered::memory_usage_info res = {};
+          buckets_.add_memory_usage(res);
+          res.nodes = size_ * sizeof(node_type);
+          res.total = res.group_metadata + res.nodes + res.buckets;
+          return res;
+        }
+
         template <class Key>
         iterator next_group(Key const& k, c_iterator n) const
         {
@@ -1416,6 +1479,7 @@ namespace boost {
         {
           x.size_ = 0;
           x.max_load_ = 0;
+          move_stats_from(x);
         }
 
         table(table& x, value_allocator const& a,
@@ -1461,6 +1525,9 @@ namespace boost {
           boost::core::invoke_swap(size_, x.size_);
           std::swap(mlf_, x.mlf_);
           std::swap(max_load_, x.max_load_);
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+          std::swap(cstats_, x.cstats_);
+#endif
         }
 
         // Nothrow swappable
@@ -1470,6 +1537,9 @@ namespace boost {
           boost::core::invoke_swap(size_, x.size_);
           std::swap(mlf_, x.mlf_);
           std::swap(max_load_, x.max_load_);
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+          std::swap(cstats_, x.cstats_);
+#endif
           this->current_functions().swap(x.current_functions());
         }
 
@@ -1496,6 +1566,17 @@ namespace boost {
 
           other.size_ = 0;
           other.max_load_ = 0;
+          move_stats_from(other);
+        }
+
+        void move_stats_from(table& other)
+        {
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+          cstats_ = other.cstats_;
+          other.reset_stats();
+#else
+          (void)other;
+#endif
         }
 
         // For use in the constructor when allocators might be different.
@@ -1506,6 +1587,9 @@ namespace boost {
             return;
           }
 
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+          src.reset_stats();
+#endif
           if (src.size_ == 0) {
             return;
           }
@@ -1701,6 +1785,9 @@ namespace boost {
           BOOST_CATCH_END
           this->switch_functions();
           move_assign_buckets(x, is_unique);
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+          x.reset_stats();
+#endif
         }
 
         // Accessors
@@ -1721,15 +1808,18 @@ namespace boost {
         node_pointer find_node_impl(Key const& x, bucket_iterator itb) const
         {
           node_pointer p = node_pointer();
+          lookup_stats_counter num_cmps;
           if (itb != buckets_.end()) {
             key_equal const& pred = this->key_eq();
             p = itb->next;
             for (; p; p = p->next) {
+              ++num_cmps;
               if (pred(x, extractor::extract(p->value()))) {
                 break;
               }
             }
           }
+          add_lookup_stats(p != node_pointer(), num_cmps);
           return p;
         }
 
@@ -1754,35 +1844,90 @@ namespace boost {
         inline iterator transparent_find(
           Key const& k, Hash const& h, Pred const& pred) const
         {
+          lookup_stats_counter num_cmps;
           if (size_ > 0) {
             std::size_t const key_hash = h(k);
             bucket_iterator itb = buckets_.at(buckets_.position(key_hash));
             for (node_pointer p = itb->next; p; p = p->next) {
+              ++num_cmps;
               if (BOOST_LIKELY(pred(k, extractor::extract(p->value())))) {
+                add_lookup_stats(true, num_cmps);
                 return iterator(p, itb);
               }
             }
           }
 
+          add_lookup_stats(false, num_cmps);
           return this->end();
         }
 
         template <class Key>
         node_pointer* find_prev(Key const& key, bucket_iterator itb)
         {
+          lookup_stats_counter num_cmps;
           if (size_ > 0) {
             key_equal pred = this->key_eq();
             for (node_pointer* pp = std::addressof(itb->next); *pp;
                  pp = std::addressof((*pp)->next)) {
+              ++num_cmps;
               if (pred(key, extractor::extract((*pp)->value()))) {
+                add_lookup_stats(true, num_cmps);
                 return pp;
               }
             }
           }
+          add_lookup_stats(false, num_cmps);
           typedef node_pointer* node_pointer_pointer;
           return node_pointer_pointer();
         }
 
+        ////////////////////////////////////////////////////////////////////////
+        // Stats
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+        void add_lookup_stats(bool found, lookup_stats_counter num_cmps) const
+        {
+          if (found) {
+            cstats_.successful_lookup.add(num_cmps.n);
+          } else {
+            cstats_.unsuccessful_lookup.add(num_cmps.n);
+          }
+        }
+
+        table_stats get_stats() const
+        {
+          auto successful_lookup = cstats_.successful_lookup.get_summary();
+          auto unsuccessful_lookup = cstats_.unsuccessful_lookup.get_summary();
+          return {{successful_lookup.count,
+                    successful_lookup.sequence_summary[0]},
+            {unsuccessful_lookup.count,
+              unsuccessful_lookup.sequence_summary[0]},
+            {cstats_.num_rehashes, cstats_.rehash_time}, bucket_sizes()};
+        }
+
+        // Number of buckets per chain length, calculated on the spot.
+        boost::unordered::detail::foa::sequence_histogram bucket_sizes() const
+        {
+          typedef boost::unordered::detail::foa::sequence_histogram histogram;
+
+          histogram res{};
+          for (std::size_t i = 0; i < bucket_count(); ++i) {
+            ++res.counts[histogram::bucket_for(bucket_size(i))];
+          }
+          return res;
+        }
+
+        void reset_stats() noexcept
+        {
+          cstats_.successful_lookup.reset();
+          cstats_.unsuccessful_lookup.reset();
+          cstats_.num_rehashes = 0;
+          cstats_.rehash_time = std::chrono::nanoseconds(0);
+        }
+#else
+        void add_lookup_stats(bool, lookup_stats_counter) const {}
+#endif
+
         // Extract and erase
 
         template <class Key> node_pointer extract_by_key_impl(Key const& k)
@@ -2758,8 +2903,14 @@ namespace boost {
       template <class Types>
       inline void table<Types>::rehash_impl(std::size_t num_buckets)
       {
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+        auto const t0 = std::chrono::steady_clock::now();
+#endif
         bucket_array_type new_buckets(
           num_buckets, buckets_.get_allocator());
+        boost::unordered::detail::default_rehash_notifier rn(this,
+          bucket_count(), new_buckets.bucket_count(), size_,
+          new_buckets.allocated_bytes());
 
         BOOST_TRY
         {
@@ -2798,6 +2949,13 @@ namespace boost {
 
         buckets_ = std::move(new_buckets);
         recalculate_max_load();
+        rn.notify_completion();
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+        ++cstats_.num_rehashes;
+        cstats_.rehash_time +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0);
+#endif
       }
 
 #if defined(BOOST_MSVC)
@@ -0,0 +1,148 @@
+/* Support for parallel algorithms in containers.
+ *
+ * Copyright 2023-2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_PARALLEL_ALGORITHMS_HPP
+#define BOOST_UNORDERED_DETAIL_PARALLEL_ALGORITHMS_HPP
+
+#include <boost/config.hpp>
+#include <type_traits>
+#include <utility>
+
+#if !defined(BOOST_UNORDERED_DISABLE_PARALLEL_ALGORITHMS)
+#if defined(BOOST_UNORDERED_ENABLE_PARALLEL_ALGORITHMS)|| \
+    !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+#define BOOST_UNORDERED_PARALLEL_ALGORITHMS
+#endif
+#endif
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#endif
+
+namespace boost{
+namespace unordered{
+
+class work_stealing_executor;
+
+namespace detail{
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+
+template<typename ExecutionPolicy>
+using is_execution_policy=std::is_execution_policy<
+  typename std::remove_cv<
+    typename std::remove_reference<ExecutionPolicy>::type
+  >::type
+>;
+
+#else
+
+template<typename ExecutionPolicy>
+using is_execution_policy=std::false_type;
+
+#endif
+
+/* Parallel traversals accept either a standard execution policy or a
+ * boost::unordered::work_stealing_executor, the latter being available
+ * regardless of stdlib support for parallel algorithms.
+ */
+
+template<typename Executor>
+using is_work_stealing_executor=std::is_same<
+  typename std::remove_cv<
+    typename std::remove_reference<Executor>::type
+  >::type,
+  work_stealing_executor
+>;
+
+template<typename Executor>
+using is_parallel_executor=std::integral_constant<
+  bool,
+  is_execution_policy<Executor>::value||
+  is_work_stealing_executor<Executor>::value
+>;
+
+template<typename Executor,typename RandomIt,typename F>
+typename std::enable_if<is_work_stealing_executor<Executor>::value>::type
+parallel_for_each(Executor&& ex,RandomIt first,RandomIt last,F f)
+{
+  ex.for_each(first,last,f);
+}
+
+template<typename Executor,typename RandomIt,typename F>
+typename std::enable_if<is_work_stealing_executor<Executor>::value,bool>::type
+parallel_all_of(Executor&& ex,RandomIt first,RandomIt last,F f)
+{
+  return ex.all_of(first,last,f);
+}
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+template<typename ExecutionPolicy,typename RandomIt,typename F>
+typename std::enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+parallel_for_each(ExecutionPolicy&& policy,RandomIt first,RandomIt last,F f)
+{
+  std::for_each(std::forward<ExecutionPolicy>(policy),first,last,f);
+}
+
+template<typename ExecutionPolicy,typename RandomIt,typename F>
+typename std::enable_if<is_execution_policy<ExecutionPolicy>::value,bool>::type
+parallel_all_of(ExecutionPolicy&& policy,RandomIt first,RandomIt last,F f)
+{
+  return std::all_of(std::forward<ExecutionPolicy>(policy),first,last,f);
+}
+#endif
+
+/* Partial result of transform_reduce over a subrange of elements. As the
+ * reduction operation need not have an identity element, the partial result
+ * can be empty, in which case value is just a placeholder.
+ */
+
+template<typename T>
+struct partial_reduction
+{
+  partial_reduction(const T& x):value(x){}
+
+  template<typename BinaryOp,typename U>
+  void add(BinaryOp& op,U&& x)
+  {
+    if(engaged)value=op(std::move(value),std::forward<U>(x));
+    else{
+      value=std::forward<U>(x);
+      engaged=true;
+    }
+  }
+
+  template<typename BinaryOp>
+  static partial_reduction combine(
+    BinaryOp& op,partial_reduction&& x,partial_reduction&& y)
+  {
+    if(!x.engaged)return std::move(y);
+    if(y.engaged)x.value=op(std::move(x.value),std::move(y.value));
+    return std::move(x);
+  }
+
+  template<typename BinaryOp>
+  T result(BinaryOp& op,T&& init)&&
+  {
+    if(engaged)return op(std::move(init),std::move(value));
+    else       return std::move(init);
+  }
+
+  T    value;
+  bool engaged=false;
+};
+
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
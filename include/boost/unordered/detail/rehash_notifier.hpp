@@ -0,0 +1,94 @@
+/* Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_REHASH_NOTIFIER_HPP
+#define BOOST_UNORDERED_DETAIL_REHASH_NOTIFIER_HPP
+
+#include <boost/config.hpp>
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#pragma once
+#endif
+
+#include <boost/unordered/rehash_observer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+/* Globally define BOOST_UNORDERED_REHASH_OBSERVER to some class with the
+ * same interface as null_rehash_observer to be notified of every rehash
+ * performed by any container.
+ */
+
+#if !defined(BOOST_UNORDERED_REHASH_OBSERVER)
+#define BOOST_UNORDERED_REHASH_OBSERVER boost::unordered::null_rehash_observer
+#endif
+
+namespace boost{
+namespace unordered{
+namespace detail{
+
+/* Issues before_rehash on construction and after_rehash on
+ * notify_completion, to be called if and only if the container ends up
+ * using the new bucket array. This is not the case when rehashing fails,
+ * except for cooperative rehashing of concurrent containers, which
+ * completes dropping the elements whose transfer threw (num_lost).
+ * Compiles to nothing for null_rehash_observer, so that time is not
+ * measured unless needed.
+ */
+
+template<typename Observer>
+class rehash_notifier
+{
+  static_assert(
+    noexcept(Observer::before_rehash(std::declval<const rehash_info&>()))&&
+    noexcept(Observer::after_rehash(std::declval<const rehash_info&>())),
+    "Rehash observer notifications must not throw.");
+
+public:
+  rehash_notifier(
+    const void* container,std::size_t old_bucket_count,
+    std::size_t new_bucket_count,std::size_t size,
+    std::size_t bytes_allocated)noexcept:
+    info{
+      container,old_bucket_count,new_bucket_count,size,bytes_allocated,
+      std::chrono::nanoseconds{0},0}
+  {
+    Observer::before_rehash(info);
+    t0=std::chrono::steady_clock::now();
+  }
+
+  void notify_completion(std::size_t num_lost=0)noexcept
+  {
+    info.elapsed=std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now()-t0);
+    info.num_lost=num_lost;
+    Observer::after_rehash(info);
+  }
+
+private:
+  rehash_info                           info;
+  std::chrono::steady_clock::time_point t0;
+};
+
+template<>
+class rehash_notifier<null_rehash_observer>
+{
+public:
+  rehash_notifier(
+    const void*,std::size_t,std::size_t,std::size_t,std::size_t)noexcept{}
+
+  void notify_completion(std::size_t=0)noexcept{}
+};
+
+using default_rehash_notifier=rehash_notifier<BOOST_UNORDERED_REHASH_OBSERVER>;
+
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
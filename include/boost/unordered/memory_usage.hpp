@@ -0,0 +1,40 @@
+/* Breakdown of the dynamic memory held by a container.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_MEMORY_USAGE_HPP
+#define BOOST_UNORDERED_MEMORY_USAGE_HPP
+
+#include <boost/config.hpp>
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#pragma once
+#endif
+
+#include <cstddef>
+
+namespace boost{
+namespace unordered{
+
+/* All figures in bytes as requested from the allocator. */
+
+struct memory_usage_info
+{
+  std::size_t group_metadata; /* FOA groups, FCA bucket groups             */
+  std::size_t element_slots;  /* FOA element array (values or node ptrs)   */
+  std::size_t nodes;          /* separately allocated elements             */
+  std::size_t locks;          /* concurrent group locks and reclamation    */
+  std::size_t buckets;        /* FCA bucket array                          */
+  std::size_t other;          /* container-level bookkeeping (shards)      */
+  std::size_t total;
+};
+
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
@@ -0,0 +1,45 @@
+/* Notification of rehashing events.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_REHASH_OBSERVER_HPP
+#define BOOST_UNORDERED_REHASH_OBSERVER_HPP
+
+#include <boost/config.hpp>
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#pragma once
+#endif
+
+#include <chrono>
+#include <cstddef>
+
+namespace boost{
+namespace unordered{
+
+struct rehash_info
+{
+  const void*              container;
+  std::size_t              old_bucket_count;
+  std::size_t              new_bucket_count;
+  std::size_t              size;
+  std::size_t              bytes_allocated;
+  std::chrono::nanoseconds elapsed;
+  std::size_t              num_lost;
+};
+
+struct null_rehash_observer
+{
+  static void before_rehash(const rehash_info&)noexcept{}
+  static void after_rehash(const rehash_info&)noexcept{}
+};
+
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
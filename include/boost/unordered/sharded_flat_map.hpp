@@ -0,0 +1,317 @@
+/* Partitioned hash map with single-writer shards.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_SHARDED_FLAT_MAP_HPP
+#define BOOST_UNORDERED_SHARDED_FLAT_MAP_HPP
+
+#include <boost/unordered/detail/foa/concurrent_table.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <boost/config.hpp>
+#include <boost/container_hash/hash_is_avalanching.hpp>
+#include <boost/core/bit.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+  namespace unordered {
+
+    /* Tag for construction of sharded_flat_map with synchronized
+     * cross-shard reads.
+     */
+
+    struct cross_shard_reads_t
+    {
+      explicit cross_shard_reads_t() = default;
+    };
+    BOOST_INLINE_CONSTEXPR cross_shard_reads_t cross_shard_reads{};
+
+    /* Hash map split into a power-of-two number of shards, each a plain
+     * unordered_flat_map meant to be written to by one thread only. Keys are
+     * routed to shards by some bits of their mixed hash value: the lowest
+     * byte is used by the shards for in-group matching and the highest bits
+     * determine the position in the bucket array, so shard selection takes
+     * the bits immediately above the lowest byte lest elements of a shard
+     * cluster in some region of its bucket array.
+     *
+     * By default, writes take no locks and reading a shard is only safe
+     * from its writer thread or while no write is in progress. If constructed
+     * with cross_shard_reads, each shard is protected by a read-write
+     * spinlock, which every write locks exclusively (uncontended unless
+     * readers from other threads hold it shared).
+     */
+
+    template <class Key, class T, class Hash = boost::hash<Key>,
+      class Pred = std::equal_to<Key>,
+      class Allocator = std::allocator<std::pair<const Key, T> > >
+    class sharded_flat_map
+    {
+      using mix_policy = typename std::conditional<
+        boost::hash_is_avalanching<Hash>::value, detail::foa::no_mix,
+        detail::foa::mulx_mix>::type;
+      using mutex_type = detail::foa::rw_spinlock;
+
+      static constexpr std::size_t shard_shift = 8;
+
+    public:
+      using shard_type = unordered_flat_map<Key, T, Hash, Pred, Allocator>;
+      using key_type = Key;
+      using mapped_type = T;
+      using value_type = typename shard_type::value_type;
+      using init_type = typename shard_type::init_type;
+      using size_type = std::size_t;
+      using hasher = typename shard_type::hasher;
+      using key_equal = typename shard_type::key_equal;
+      using allocator_type = typename shard_type::allocator_type;
+
+      explicit sharded_flat_map(size_type num_shards,
+        const hasher& hf = hasher(), const key_equal& eql = key_equal(),
+        const allocator_type& a = allocator_type())
+          : sharded_flat_map(num_shards, false, hf, eql, a)
+      {
+      }
+
+      sharded_flat_map(cross_shard_reads_t, size_type num_shards,
+        const hasher& hf = hasher(), const key_equal& eql = key_equal(),
+        const allocator_type& a = allocator_type())
+          : sharded_flat_map(num_shards, true, hf, eql, a)
+      {
+      }
+
+      sharded_flat_map(sharded_flat_map const&) = delete;
+      sharded_flat_map& operator=(sharded_flat_map const&) = delete;
+
+      size_type shard_count() const noexcept { return shards_.size(); }
+      bool has_cross_shard_reads() const noexcept { return synchronized_; }
+
+      /// Routing
+      ///
+      size_type shard_for(key_type const& k) const
+      {
+        return (mix_policy::mix(h_, k) >> shard_shift) & (shards_.size() - 1);
+      }
+
+      shard_type& shard(size_type i) noexcept
+      {
+        BOOST_ASSERT(i < shards_.size());
+        return shards_[i].table;
+      }
+
+      shard_type const& shard(size_type i) const noexcept
+      {
+        BOOST_ASSERT(i < shards_.size());
+        return shards_[i].table;
+      }
+
+      /// Writer Operations
+      ///
+      /* to be invoked by the writer thread of the shard involved */
+
+      template <class F>
+      auto with_shard(size_type i, F f)
+        -> decltype(f(std::declval<shard_type&>()))
+      {
+        BOOST_ASSERT(i < shards_.size());
+        exclusive_guard lck{*this, shards_[i]};
+        return f(shards_[i].table);
+      }
+
+      bool insert(init_type const& obj)
+      {
+        return with_key_shard(obj.first,
+          [&](shard_type& s) { return s.insert(obj).second; });
+      }
+
+      bool insert(init_type&& obj)
+      {
+        return with_key_shard(obj.first,
+          [&](shard_type& s) { return s.insert(std::move(obj)).second; });
+      }
+
+      template <class... Args>
+      bool try_emplace(key_type const& k, Args&&... args)
+      {
+        return with_key_shard(k, [&](shard_type& s) {
+          return s.try_emplace(k, std::forward<Args>(args)...).second;
+        });
+      }
+
+      template <class M> bool insert_or_assign(key_type const& k, M&& obj)
+      {
+        return with_key_shard(k, [&](shard_type& s) {
+          return s.insert_or_assign(k, std::forward<M>(obj)).second;
+        });
+      }
+
+      size_type erase(key_type const& k)
+      {
+        return with_key_shard(k, [&](shard_type& s) { return s.erase(k); });
+      }
+
+      void clear() noexcept
+      {
+        for (auto& s : shards_) {
+          exclusive_guard lck{*this, s};
+          s.table.clear();
+        }
+      }
+
+      void reserve(size_type n)
+      {
+        for (auto& s : shards_) {
+          exclusive_guard lck{*this, s};
+          s.table.reserve(n / shards_.size() + 1);
+        }
+      }
+
+      /// Reader Operations
+      ///
+      /* safe from any thread only if constructed with cross_shard_reads */
+
+      template <class F> size_type cvisit(key_type const& k, F f) const
+      {
+        auto const& s = shards_[shard_for(k)];
+        shared_lock_type lck{s.mtx, synchronized_};
+        auto it = s.table.find(k);
+        if (it == s.table.end()) return 0;
+        f(*it);
+        return 1;
+      }
+
+      size_type count(key_type const& k) const
+      {
+        return cvisit(k, [](value_type const&) {});
+      }
+
+      bool contains(key_type const& k) const { return count(k) != 0; }
+
+      size_type size() const noexcept
+      {
+        size_type res = 0;
+        for (auto const& s : shards_) {
+          shared_lock_type lck{s.mtx, synchronized_};
+          res += s.table.size();
+        }
+        return res;
+      }
+
+      /* shard locks are counted as locks, the rest of the shard array
+       * (table objects, padding) as other
+       */
+
+      memory_usage_info memory_usage() const noexcept
+      {
+        memory_usage_info res{};
+        for (auto const& s : shards_) {
+          shared_lock_type lck{s.mtx, synchronized_};
+          auto r = s.table.memory_usage();
+          res.group_metadata += r.group_metadata;
+          res.element_slots += r.element_slots;
+        }
+        res.locks = shards_.size() * sizeof(mutex_type);
+        res.other = shards_.capacity() * sizeof(shard_holder) - res.locks;
+        res.total =
+          res.group_metadata + res.element_slots + res.locks + res.other;
+        return res;
+      }
+
+      BOOST_ATTRIBUTE_NODISCARD bool empty() const noexcept
+      {
+        return size() == 0;
+      }
+
+      /// Observers
+      ///
+      hasher hash_function() const { return h_; }
+      key_equal key_eq() const { return shards_[0].table.key_eq(); }
+      allocator_type get_allocator() const noexcept
+      {
+        return shards_[0].table.get_allocator();
+      }
+
+    private:
+      using shared_lock_type = detail::foa::shared_lock<mutex_type>;
+
+      /* Trailing padding keeps the locks and table headers of adjacent
+       * shards in different cache lines.
+       */
+
+      struct shard_holder
+      {
+        shard_holder(
+          const hasher& hf, const key_equal& eql, const allocator_type& a)
+            : table(0, hf, eql, a)
+        {
+        }
+
+        /* only invoked on construction of shards_ */
+        shard_holder(shard_holder&& x) : table(std::move(x.table)) {}
+
+        mutable mutex_type mtx;
+        shard_type table;
+        unsigned char pad[detail::foa::cacheline_size];
+      };
+
+      struct exclusive_guard
+      {
+        exclusive_guard(sharded_flat_map& m, shard_holder& s_) noexcept
+            : s(m.synchronized_ ? &s_ : nullptr)
+        {
+          if (s) s->mtx.lock();
+        }
+
+        ~exclusive_guard()
+        {
+          if (s) s->mtx.unlock();
+        }
+
+        shard_holder* s;
+      };
+
+      sharded_flat_map(size_type num_shards, bool synchronized,
+        const hasher& hf, const key_equal& eql, const allocator_type& a)
+          : synchronized_(synchronized), h_(hf)
+      {
+        if (num_shards > 1) {
+          num_shards = size_type(1)
+                       << boost::core::bit_width(num_shards - 1);
+        } else {
+          num_shards = 1;
+        }
+        shards_.reserve(num_shards);
+        for (size_type i = 0; i < num_shards; ++i) {
+          shards_.emplace_back(hf, eql, a);
+        }
+      }
+
+      template <class F>
+      auto with_key_shard(key_type const& k, F&& f)
+        -> decltype(f(std::declval<shard_type&>()))
+      {
+        auto& s = shards_[shard_for(k)];
+        exclusive_guard lck{*this, s};
+        return f(s.table);
+      }
+
+      bool synchronized_;
+      hasher h_;
+      std::vector<shard_holder> shards_;
+    };
+  } // namespace unordered
+
+  using boost::unordered::sharded_flat_map;
+} // namespace boost
+
+#endif // BOOST_UNORDERED_SHARDED_FLAT_MAP_HPP
@@ -75,6 +75,10 @@ namespace boost {
       typedef typename types::node_type node_type;
       typedef typename types::insert_return_type insert_return_type;
 
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+      typedef boost::unordered::detail::table_stats stats;
+#endif
+
     private:
       table table_;
 
@@ -625,6 +629,19 @@ namespace boost {
       void rehash(size_type);
       void reserve(size_type);
 
+      memory_usage_info memory_usage() const noexcept
+      {
+        return table_.memory_usage();
+      }
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+      // stats
+
+      stats get_stats() const { return table_.get_stats(); }
+
+      void reset_stats() noexcept { table_.reset_stats(); }
+#endif
+
 #if !BOOST_WORKAROUND(BOOST_BORLANDC, < 0x0582)
       friend bool operator==
         <K, T, H, P, A>(unordered_map const&, unordered_map const&);
@@ -819,6 +836,10 @@ namespace boost {
       typedef typename table::cl_iterator const_local_iterator;
       typedef typename types::node_type node_type;
 
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+      typedef boost::unordered::detail::table_stats stats;
+#endif
+
     private:
       table table_;
 
@@ -1238,6 +1259,19 @@ namespace boost {
       void rehash(size_type);
       void reserve(size_type);
 
+      memory_usage_info memory_usage() const noexcept
+      {
+        return table_.memory_usage();
+      }
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+      // stats
+
+      stats get_stats() const { return table_.get_stats(); }
+
+      void reset_stats() noexcept { table_.reset_stats(); }
+#endif
+
 #if !BOOST_WORKAROUND(BOOST_BORLANDC, < 0x0582)
       friend bool operator==
         <K, T, H, P, A>(unordered_multimap const&, unordered_multimap const&);
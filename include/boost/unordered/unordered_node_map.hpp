@@ -86,6 +86,8 @@ namespace boost {
       using insert_return_type =
         detail::foa::insert_return_type<iterator, node_type>;
 
+      using layout_stats_type = typename table_type::layout_stats_type;
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       using stats = typename table_type::stats;
 #endif
@@ -787,6 +789,20 @@ namespace boost {
         return {pos, next};
       }
 
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+      /// Parallel Reduction
+      ///
+
+      template <class ExecPolicy, class R, class BinaryOp, class F>
+      typename std::enable_if<detail::is_execution_policy<ExecPolicy>::value,
+        R>::type
+      transform_reduce(
+        ExecPolicy&& p, R init, BinaryOp reduce, F transform) const
+      {
+        return table_.transform_reduce(p, std::move(init), reduce, transform);
+      }
+#endif
+
       /// Hash Policy
       ///
 
@@ -807,6 +823,13 @@ namespace boost {
 
       void reserve(size_type n) { table_.reserve(n); }
 
+      memory_usage_info memory_usage() const noexcept
+      {
+        return table_.memory_usage();
+      }
+
+      layout_stats_type layout_stats() const { return table_.layout_stats(); }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       /// Stats
       ///
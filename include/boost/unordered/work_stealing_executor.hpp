@@ -0,0 +1,281 @@
+/* Lightweight work-stealing executor for parallel traversals.
+ *
+ * Copyright 2026 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_WORK_STEALING_EXECUTOR_HPP
+#define BOOST_UNORDERED_WORK_STEALING_EXECUTOR_HPP
+
+#include <boost/unordered/detail/parallel_algorithms.hpp>
+
+#include <boost/config.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+  namespace unordered {
+
+    /* Fixed-size pool of worker threads executing index ranges in parallel.
+     * An index range [0, n) is split into as many contiguous slices as
+     * participating threads (the workers plus the thread submitting the
+     * job); each thread claims chunks from its own slice and, once this is
+     * exhausted, steals chunks from the remaining slices. Jobs submitted from
+     * different threads are executed one at a time; jobs submitted from
+     * within a running job are executed sequentially by the submitting
+     * thread.
+     */
+
+    class work_stealing_executor
+    {
+    public:
+      using size_type = std::size_t;
+
+      static size_type default_concurrency() noexcept
+      {
+        auto n = static_cast<size_type>(std::thread::hardware_concurrency());
+        return n ? n : 1;
+      }
+
+      explicit work_stealing_executor(
+        size_type concurrency = default_concurrency())
+          : concurrency_(concurrency ? concurrency : 1),
+            slices_(new slice[concurrency_])
+      {
+        workers_.reserve(concurrency_ - 1);
+        BOOST_TRY
+        {
+          for (size_type i = 1; i < concurrency_; ++i) {
+            workers_.emplace_back([this, i] { worker(i); });
+          }
+        }
+        BOOST_CATCH(...)
+        {
+          shutdown();
+          BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+      }
+
+      work_stealing_executor(work_stealing_executor const&) = delete;
+      work_stealing_executor& operator=(work_stealing_executor const&) = delete;
+
+      ~work_stealing_executor() { shutdown(); }
+
+      size_type concurrency() const noexcept { return concurrency_; }
+
+      /* Invokes f(i, j) for disjoint subranges [i, j) covering [0, n). */
+
+      template <class F> void for_each_chunk(size_type n, F f)
+      {
+        run(n, [&](size_type i, size_type j) {
+          f(i, j);
+          return true;
+        });
+      }
+
+      template <class RandomAccessIterator, class F>
+      void for_each(RandomAccessIterator first, RandomAccessIterator last, F f)
+      {
+        run(static_cast<size_type>(std::distance(first, last)),
+          [&](size_type i, size_type j) {
+            for (auto it = first + i, end = first + j; it != end; ++it) f(*it);
+            return true;
+          });
+      }
+
+      /* Stops handing out chunks as soon as f returns false for some element.
+       */
+
+      template <class RandomAccessIterator, class F>
+      bool all_of(RandomAccessIterator first, RandomAccessIterator last, F f)
+      {
+        return run(static_cast<size_type>(std::distance(first, last)),
+          [&](size_type i, size_type j) {
+            for (auto it = first + i, end = first + j; it != end; ++it) {
+              if (!f(*it)) return false;
+            }
+            return true;
+          });
+      }
+
+    private:
+      struct slice
+      {
+        std::atomic<size_type> next{0};
+        size_type end = 0;
+        unsigned char pad[64 - sizeof(std::atomic<size_type>) -
+                          sizeof(size_type)];
+      };
+
+      struct job
+      {
+        bool (*fn)(void*, size_type, size_type);
+        void* arg;
+        size_type grain;
+        std::atomic<size_type> pending;
+        std::atomic<bool> stop{false};
+        bool result = true;
+        std::exception_ptr ep;
+      };
+
+      template <class F>
+      static bool invoke(void* arg, size_type i, size_type j)
+      {
+        return (*static_cast<F*>(arg))(i, j);
+      }
+
+      static work_stealing_executor*& current() noexcept
+      {
+        static thread_local work_stealing_executor* p = nullptr;
+        return p;
+      }
+
+      struct current_guard
+      {
+        current_guard(work_stealing_executor* p) : prev(current())
+        {
+          current() = p;
+        }
+        ~current_guard() { current() = prev; }
+
+        work_stealing_executor* prev;
+      };
+
+      /* Returns true iff no invocation of f returned false. */
+
+      template <class F> bool run(size_type n, F&& f)
+      {
+        using fn_type = typename std::remove_reference<F>::type;
+
+        /* A chunk is made of at least one element, and there are some
+         * chunks per slice so that stealing can balance the load.
+         */
+
+        size_type const grain =
+          (std::max)(size_type(1), n / (concurrency_ * 8));
+        if (concurrency_ == 1 || n <= grain || current() == this) {
+          return n ? f(size_type(0), n) : true;
+        }
+
+        std::lock_guard<std::mutex> submit_lck(submit_mtx_);
+        current_guard g(this);
+
+        job j;
+        j.fn = &invoke<fn_type>;
+        j.arg = static_cast<void*>(std::addressof(f));
+        j.grain = grain;
+        j.pending.store(concurrency_ - 1, std::memory_order_relaxed);
+        for (size_type i = 0; i < concurrency_; ++i) {
+          slices_[i].next.store(n * i / concurrency_, std::memory_order_relaxed);
+          slices_[i].end = n * (i + 1) / concurrency_;
+        }
+
+        {
+          std::lock_guard<std::mutex> lck(mtx_);
+          job_ = &j;
+          ++generation_;
+        }
+        cv_.notify_all();
+
+        execute(j, 0);
+
+        {
+          std::unique_lock<std::mutex> lck(mtx_);
+          done_cv_.wait(lck, [&] {
+            return j.pending.load(std::memory_order_acquire) == 0;
+          });
+          job_ = nullptr;
+        }
+
+        if (j.ep) std::rethrow_exception(j.ep);
+        return j.result;
+      }
+
+      void execute(job& j, size_type id) noexcept
+      {
+        for (size_type k = 0; k < concurrency_; ++k) {
+          slice& s = slices_[(id + k) % concurrency_];
+          for (;;) {
+            if (j.stop.load(std::memory_order_relaxed)) return;
+            size_type i = s.next.fetch_add(j.grain, std::memory_order_relaxed);
+            if (i >= s.end) break;
+            BOOST_TRY
+            {
+              if (!j.fn(j.arg, i, (std::min)(i + j.grain, s.end))) {
+                if (!j.stop.exchange(true)) j.result = false;
+              }
+            }
+            BOOST_CATCH(...)
+            {
+              if (!j.stop.exchange(true)) j.ep = std::current_exception();
+            }
+            BOOST_CATCH_END
+          }
+        }
+      }
+
+      void worker(size_type id)
+      {
+        current_guard g(this);
+        std::size_t seen = 0;
+        for (;;) {
+          job* pj;
+          {
+            std::unique_lock<std::mutex> lck(mtx_);
+            cv_.wait(lck, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            pj = job_;
+          }
+          execute(*pj, id);
+          if (pj->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lck(mtx_);
+            done_cv_.notify_one();
+          }
+        }
+      }
+
+      void shutdown() noexcept
+      {
+        {
+          std::lock_guard<std::mutex> lck(mtx_);
+          stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& th : workers_) th.join();
+        workers_.clear();
+      }
+
+      size_type concurrency_;
+      std::unique_ptr<slice[]> slices_;
+      std::vector<std::thread> workers_;
+      std::mutex submit_mtx_;
+      std::mutex mtx_;
+      std::condition_variable cv_;
+      std::condition_variable done_cv_;
+      job* job_ = nullptr;
+      std::size_t generation_ = 0;
+      bool stopping_ = false;
+    };
+  } // namespace unordered
+
+  using boost::unordered::work_stealing_executor;
+} // namespace boost
+
+#endif // BOOST_UNORDERED_WORK_STEALING_EXECUTOR_HPP
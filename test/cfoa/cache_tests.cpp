@@ -0,0 +1,245 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_cache.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using test::default_generator;
+using test::limited_range;
+using test::sequential;
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using cache_type = boost::unordered::concurrent_flat_cache<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+cache_type* test_cache;
+
+namespace {
+  test::seed_t initialize_seed{1780441};
+
+  template <class X> void zero_capacity(X*)
+  {
+    using value_type = typename X::value_type;
+
+    X x(0);
+    BOOST_TEST_EQ(x.capacity(), 0u);
+    BOOST_TEST(!x.insert({raii{0}, raii{0}}));
+    BOOST_TEST(!x.insert_or_visit({raii{0}, raii{0}}, [](value_type&) {
+      BOOST_ERROR("visitation on an empty cache");
+    }));
+    BOOST_TEST(!x.evict());
+    BOOST_TEST(x.empty());
+    BOOST_TEST_EQ(x.memory_usage().total, 0u);
+  }
+
+  template <class X> void bounded_size(X*)
+  {
+    using allocator_type = typename X::allocator_type;
+    using value_type = typename X::value_type;
+
+    std::size_t const capacity = 1000;
+    std::size_t num_evicted = 0;
+
+    raii::reset_counts();
+
+    {
+      X x(
+        capacity,
+        [&](value_type& v) {
+          BOOST_TEST_GE(v.first.x_, 0);
+          ++num_evicted;
+        },
+        hasher(1), key_equal(2), allocator_type(3));
+      BOOST_TEST_EQ(x.capacity(), capacity);
+      BOOST_TEST_EQ(x.hash_function(), hasher(1));
+      BOOST_TEST_EQ(x.key_eq(), key_equal(2));
+      BOOST_TEST(x.get_allocator() == allocator_type(3));
+
+      // memory is allocated once at construction
+      auto memory_usage = x.memory_usage();
+      BOOST_TEST_GE(memory_usage.group_metadata, capacity);
+
+      for (int i = 0; i < static_cast<int>(10 * capacity); ++i) {
+        BOOST_TEST(x.insert({raii{i}, raii{i}}));
+        BOOST_TEST_LE(x.size(), capacity);
+      }
+      BOOST_TEST_EQ(x.size(), capacity);
+      BOOST_TEST_EQ(x.memory_usage().total, memory_usage.total);
+      BOOST_TEST_EQ(num_evicted, 9 * capacity);
+
+      // existing elements are visited rather than evicting others
+
+      std::size_t num_present = 0;
+      for (int i = 0; i < static_cast<int>(10 * capacity); ++i) {
+        if (x.contains(raii{i})) {
+          ++num_present;
+          BOOST_TEST(!x.insert_or_visit(
+            {raii{i}, raii{i}}, [](value_type& v) { ++v.second.x_; }));
+          BOOST_TEST(!x.try_emplace(raii{i}, i));
+          BOOST_TEST(!x.insert_or_assign(raii{i}, raii{-i}));
+          BOOST_TEST_EQ(x.cvisit(raii{i}, [&](value_type const& v) {
+            BOOST_TEST_EQ(v.second.x_, -i);
+          }), 1u);
+        }
+      }
+      BOOST_TEST_EQ(num_present, capacity);
+      BOOST_TEST_EQ(num_evicted, 9 * capacity);
+
+      std::vector<int> keys;
+      x.visit_all([&](value_type const& v) { keys.push_back(v.first.x_); });
+      BOOST_TEST_EQ(keys.size(), capacity);
+      BOOST_TEST_EQ(x.erase(raii{-1}), 0u);
+      for (auto k : keys) {
+        BOOST_TEST_EQ(x.erase(raii{k}), 1u);
+      }
+      BOOST_TEST(x.empty());
+      BOOST_TEST_EQ(num_evicted, 9 * capacity);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void referenced_elements_survive(X*)
+  {
+    std::size_t const capacity = 1024;
+    int const num_hot = 16;
+
+    X x(capacity);
+    for (int i = 0; i < static_cast<int>(capacity); ++i) {
+      x.emplace(raii{num_hot + i}, raii{i});
+    }
+
+    // clear all reference bits
+    BOOST_TEST(x.evict());
+    BOOST_TEST_EQ(x.size(), capacity - 1);
+
+    for (int i = 0; i < num_hot; ++i) {
+      BOOST_TEST(x.emplace(raii{i}, raii{i}));
+    }
+
+    int key = static_cast<int>(capacity) + num_hot;
+    for (int n = 0; n < static_cast<int>(8 * capacity); ++n) {
+      BOOST_TEST(x.try_emplace(raii{key++}, n));
+      BOOST_TEST_LE(x.size(), capacity);
+      for (int i = 0; i < num_hot; ++i) {
+        BOOST_TEST_EQ(x.visit(raii{i}, [](typename X::value_type&) {}), 1u);
+      }
+    }
+  }
+
+  template <class X, class GF>
+  void concurrent_insert_and_visit(
+    X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+    using T = span_value_type<decltype(values)>;
+
+    raii::reset_counts();
+
+    {
+      std::size_t const capacity = reference_cont.size() / 4;
+      std::atomic<std::size_t> num_inserted{0};
+      std::atomic<std::size_t> num_evicted{0};
+
+      X x(capacity, [&](value_type&) { ++num_evicted; });
+
+      thread_runner(values, [&](boost::span<T> s) {
+        for (auto const& v : s) {
+          if (x.insert(v)) ++num_inserted;
+          x.visit(get_key(v), [](value_type& w) { (void)w; });
+        }
+      });
+
+      BOOST_TEST_LE(x.size(), capacity + num_threads);
+      BOOST_TEST_EQ(num_inserted, x.size() + num_evicted);
+      x.visit_all([&](value_type const& v) {
+        BOOST_TEST(reference_cont.contains(get_key(v)));
+      });
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X, class GF>
+  void clear_while_inserting(X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    using T = span_value_type<decltype(values)>;
+
+    raii::reset_counts();
+
+    {
+      std::size_t const capacity = 256;
+      std::atomic<bool> done{false};
+
+      X x(capacity, [&](value_type& v) { BOOST_TEST_GE(v.first.x_, 0); });
+      for (auto const& v : values) {
+        if (x.size() == capacity) break;
+        x.insert(v);
+      }
+
+      std::thread clearer([&] {
+        while (!done) {
+          x.clear();
+          std::this_thread::yield();
+        }
+      });
+
+      thread_runner(values, [&](boost::span<T> s) {
+        for (auto const& v : s) {
+          x.insert(v);
+          BOOST_TEST_LE(x.size(), capacity + num_threads);
+        }
+      });
+
+      done = true;
+      clearer.join();
+      BOOST_TEST_LE(x.size(), capacity);
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  zero_capacity,
+  ((test_cache)))
+
+UNORDERED_TEST(
+  bounded_size,
+  ((test_cache)))
+
+UNORDERED_TEST(
+  referenced_elements_survive,
+  ((test_cache)))
+
+UNORDERED_TEST(
+  concurrent_insert_and_visit,
+  ((test_cache))
+  ((value_type_generator_factory)(init_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+
+UNORDERED_TEST(
+  clear_while_inserting,
+  ((test_cache))
+  ((value_type_generator_factory))
+  ((default_generator)))
+// clang-format on
+
+RUN_TESTS()
@@ -0,0 +1,301 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/combining_buffer.hpp>
+#include <boost/unordered/concurrent_flat_map.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+map_type* test_map;
+
+namespace {
+  test::seed_t initialize_seed{2270179};
+
+  struct add_raii
+  {
+    raii operator()(raii x, raii const& y) const { return raii{x.x_ + y.x_}; }
+  };
+
+  template <class X> void check_sums(X& x, std::vector<int> const& sums)
+  {
+    using value_type = typename X::value_type;
+
+    std::size_t num_keys = 0;
+    for (auto s : sums) {
+      if (s) ++num_keys;
+    }
+    BOOST_TEST_EQ(x.size(), num_keys);
+    x.cvisit_all([&](value_type const& v) {
+      BOOST_TEST_EQ(v.second.x_, sums[static_cast<std::size_t>(v.first.x_)]);
+    });
+  }
+
+  template <class X> void emplace_or_combine(X*)
+  {
+    int const n = 1000, num_keys = 100;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      std::vector<int> sums(num_keys, 0);
+
+      for (int i = 0; i < n; ++i) {
+        raii const k{i % num_keys};
+        bool const inserted = i % 2 ? x.emplace_or_combine(k, raii{i}, add_raii())
+                                    : x.emplace_or_combine(raii{i % num_keys},
+                                        raii{i}, add_raii());
+        BOOST_TEST_EQ(inserted, i < num_keys);
+        sums[static_cast<std::size_t>(i % num_keys)] += i;
+      }
+      check_sums(x, sums);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void bulk_insert_or_combine(X*)
+  {
+    using init_type = typename X::init_type;
+
+    int const n = 1000, num_keys = 300;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      std::vector<int> sums(num_keys, 0);
+
+      for (int i = 0; i < num_keys / 3; ++i) x.emplace(raii{i}, raii{0});
+
+      std::vector<init_type> values;
+      for (int i = 0; i < n; ++i) {
+        values.emplace_back(raii{i % num_keys}, raii{1});
+        ++sums[static_cast<std::size_t>(i % num_keys)];
+      }
+
+      BOOST_TEST_EQ(
+        x.insert_or_combine(values.begin(), values.end(), add_raii()),
+        static_cast<std::size_t>(num_keys - num_keys / 3));
+      check_sums(x, sums);
+
+      for (auto& s : sums) s *= 2;
+      BOOST_TEST_EQ(x.insert_or_combine(std::make_move_iterator(values.begin()),
+                      std::make_move_iterator(values.end()), add_raii()),
+        0u);
+      check_sums(x, sums);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void combining_buffer_flush(X*)
+  {
+    using buffer_type = boost::unordered::combining_buffer<X, add_raii>;
+
+    int const n = 1000, num_keys = 64;
+    std::size_t const capacity = 16;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      std::vector<int> sums(num_keys, 0);
+
+      {
+        buffer_type buf(x, add_raii(), capacity);
+        BOOST_TEST_EQ(buf.capacity(), capacity);
+        BOOST_TEST(buf.empty());
+
+        for (int i = 0; i < n; ++i) {
+          buf.emplace_or_combine(raii{i % num_keys}, raii{1});
+          ++sums[static_cast<std::size_t>(i % num_keys)];
+          BOOST_TEST_LE(buf.size(), capacity);
+        }
+        BOOST_TEST(!buf.empty());
+
+        BOOST_TEST_EQ(buf.flush(), 0u);
+        BOOST_TEST(buf.empty());
+        check_sums(x, sums);
+
+        // hot keys are absorbed by the buffer
+        for (int i = 0; i < n; ++i) {
+          raii const k{i % 4};
+          buf.emplace_or_combine(k, raii{1});
+          ++sums[static_cast<std::size_t>(i % 4)];
+        }
+        BOOST_TEST_EQ(buf.size(), 4u);
+
+        BOOST_TEST_EQ(buf.flush(), 0u);
+        BOOST_TEST(buf.empty());
+      }
+
+      check_sums(x, sums);
+    }
+
+    check_raii_counts();
+  }
+
+  struct throwing_add
+  {
+    raii operator()(raii x, raii const& y) const
+    {
+      if (y.x_ < 0) throw std::runtime_error("negative update");
+      return raii{x.x_ + y.x_};
+    }
+  };
+
+  template <class X> void combining_buffer_throwing_flush(X*)
+  {
+    using buffer_type = boost::unordered::combining_buffer<X, throwing_add>;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      x.emplace(raii{0}, raii{1});
+
+      {
+        buffer_type buf(x);
+        buf.emplace_or_combine(raii{0}, raii{-1});
+        BOOST_TEST_THROWS(buf.flush(), std::runtime_error);
+        BOOST_TEST(buf.empty());
+      }
+
+      // pending updates are discarded on stack unwinding
+      BOOST_TEST_THROWS(([&] {
+        buffer_type buf(x);
+        buf.emplace_or_combine(raii{0}, raii{1});
+        throw std::runtime_error("aborted");
+      }()),
+        std::runtime_error);
+
+      BOOST_TEST_EQ(x.size(), 1u);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void combining_buffer_fixed_capacity(X*)
+  {
+    using value_type = typename X::value_type;
+    using init_type = typename X::init_type;
+    using buffer_type = boost::unordered::combining_buffer<X, add_raii>;
+
+    int const num_keys = 1000;
+
+    raii::reset_counts();
+
+    {
+      X x(boost::unordered::fixed_capacity, 100);
+      std::size_t const max_load = x.max_load();
+
+      // updates for keys the full map has no room for are dropped
+      std::vector<init_type> values;
+      for (int i = 0; i < num_keys; ++i) values.emplace_back(raii{i}, raii{1});
+      std::size_t const inserted =
+        x.insert_or_combine(values.begin(), values.end(), add_raii());
+      BOOST_TEST_EQ(inserted, max_load);
+      BOOST_TEST_EQ(x.size(), max_load);
+
+      {
+        buffer_type buf(x, add_raii(), 64);
+        for (int i = 0; i < num_keys; ++i) {
+          buf.emplace_or_combine(raii{i}, raii{1});
+        }
+
+        // covers the automatic flushes done when the buffer was full
+        BOOST_TEST_EQ(buf.flush(), num_keys - max_load);
+        BOOST_TEST_EQ(buf.flush(), 0u);
+      }
+
+      BOOST_TEST_EQ(x.size(), max_load);
+      x.cvisit_all([](value_type const& v) {
+        BOOST_TEST_EQ(v.second.x_, 2);
+      });
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void concurrent_skewed_combine(X*)
+  {
+    using buffer_type = boost::unordered::combining_buffer<X, add_raii>;
+
+    int const n = 1024 * 64, num_keys = 1024;
+
+    // heavily skewed key distribution, a handful of keys take most updates
+    std::minstd_rand rng(7);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<int> keys;
+    std::vector<int> sums(num_keys, 0);
+    for (int i = 0; i < n; ++i) {
+      auto k = static_cast<int>(num_keys * std::pow(dist(rng), 8.0));
+      keys.push_back(k);
+      ++sums[static_cast<std::size_t>(k)];
+    }
+
+    raii::reset_counts();
+
+    {
+      X x;
+
+      thread_runner(keys, [&](boost::span<int> s) {
+        buffer_type buf(x, add_raii(), 64);
+        for (std::size_t i = 0; i < s.size(); ++i) {
+          if (i % 2) {
+            buf.emplace_or_combine(raii{s[i]}, raii{1});
+          } else {
+            x.emplace_or_combine(raii{s[i]}, raii{1}, add_raii());
+          }
+        }
+        BOOST_TEST_EQ(buf.flush(), 0u);
+      });
+
+      check_sums(x, sums);
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  emplace_or_combine,
+  ((test_map)))
+
+UNORDERED_TEST(
+  bulk_insert_or_combine,
+  ((test_map)))
+
+UNORDERED_TEST(
+  combining_buffer_flush,
+  ((test_map)))
+
+UNORDERED_TEST(
+  combining_buffer_throwing_flush,
+  ((test_map)))
+
+UNORDERED_TEST(
+  combining_buffer_fixed_capacity,
+  ((test_map)))
+
+UNORDERED_TEST(
+  concurrent_skewed_combine,
+  ((test_map)))
+// clang-format on
+
+RUN_TESTS()
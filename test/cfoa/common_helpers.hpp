@@ -1,11 +1,12 @@
 // Copyright (C) 2023 Christian Mazakas
-// Copyright (C) 2023-2024 Joaquin M Lopez Munoz
+// Copyright (C) 2023-2026 Joaquin M Lopez Munoz
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
   
 #ifndef BOOST_UNORDERED_TEST_CFOA_COMMON_HELPERS_HPP
 #define BOOST_UNORDERED_TEST_CFOA_COMMON_HELPERS_HPP
 
+#include <boost/unordered/concurrent_flat_cache_fwd.hpp>
 #include <boost/unordered/concurrent_flat_map_fwd.hpp>
 #include <boost/unordered/concurrent_flat_set_fwd.hpp>
 #include <boost/unordered/concurrent_node_map_fwd.hpp>
@@ -68,6 +69,12 @@ struct reference_container_impl<boost::concurrent_flat_map<K, V, H, P, A> >
   using type = boost::unordered_flat_map<K, V>;
 };
 
+template <typename K, typename V, typename H, typename P, typename A>
+struct reference_container_impl<boost::concurrent_flat_cache<K, V, H, P, A> >
+{
+  using type = boost::unordered_flat_map<K, V>;
+};
+
 template <typename K, typename V, typename H, typename P, typename A>
 struct reference_container_impl<boost::concurrent_node_map<K, V, H, P, A> >
 {
@@ -0,0 +1,141 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+struct countdown_hash
+{
+  // throws when the countdown reaches zero
+  static std::atomic<int> countdown;
+
+  std::size_t operator()(raii const& x) const
+  {
+    if (countdown.load() > 0 && --countdown == 0) {
+      throw std::runtime_error("countdown_hash");
+    }
+    return boost::hash<int>()(x.x_);
+  }
+};
+
+std::atomic<int> countdown_hash::countdown{0};
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii>;
+using node_map_type = boost::unordered::concurrent_node_map<raii, raii>;
+using set_type = boost::unordered::concurrent_flat_set<raii>;
+using node_set_type = boost::unordered::concurrent_node_set<raii>;
+
+map_type* test_map;
+node_map_type* test_node_map;
+set_type* test_set;
+node_set_type* test_node_set;
+
+namespace {
+  test::seed_t initialize_seed{7741203};
+
+  raii make_value(raii*, int k) { return raii{k}; }
+
+  template <class Value> Value make_value(Value*, int k)
+  {
+    return {raii{k}, raii{k}};
+  }
+
+  template <class X> void insert_through_rehashes(X*)
+  {
+    using value_type = typename X::value_type;
+
+    // large enough for rehashing to be done cooperatively
+    int const n = 1024 * 64;
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[static_cast<std::size_t>(i)] = i;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      std::atomic<std::size_t> num_visits{0};
+
+      thread_runner(keys, [&](boost::span<int> s) {
+        for (auto k : s) {
+          x.insert(make_value(static_cast<value_type*>(nullptr), k));
+          num_visits += x.cvisit(raii{k / 2}, [&](value_type const& v) {
+            BOOST_TEST_EQ(get_key(v).x_, k / 2);
+          });
+        }
+      });
+
+      BOOST_TEST_EQ(x.size(), keys.size());
+      BOOST_TEST_GE(x.bucket_count(), keys.size());
+      for (auto k : keys) BOOST_TEST(x.contains(raii{k}));
+      BOOST_TEST_GT(num_visits.load(), 0u);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void throwing_hash_during_rehash(X*)
+  {
+    raii::reset_counts();
+
+    {
+      X x;
+      int i = 0;
+      while (x.size() < 4096) x.emplace(raii{i}, raii{i}), ++i;
+      auto const bucket_count = x.bucket_count();
+      while (x.size() < x.max_load()) x.emplace(raii{i}, raii{i}), ++i;
+      BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+
+      // next insertion triggers a rehash, during which one element is lost
+      int const num_elements = i;
+      countdown_hash::countdown = 1000;
+      BOOST_TEST_THROWS(x.emplace(raii{-1}, raii{-1}), std::runtime_error);
+      countdown_hash::countdown = 0;
+
+      BOOST_TEST_GT(x.bucket_count(), bucket_count);
+      BOOST_TEST_EQ(x.size() + 1, static_cast<std::size_t>(num_elements));
+      std::size_t num_found = 0;
+      for (int j = 0; j < num_elements; ++j) {
+        num_found += x.cvisit(raii{j}, [&](typename X::value_type const& v) {
+          BOOST_TEST_EQ(v.second.x_, j);
+        });
+      }
+      BOOST_TEST_EQ(num_found, x.size());
+      BOOST_TEST_NOT(x.contains(raii{-1}));
+
+      // the container is fully usable afterwards
+      for (int j = 0; j < num_elements * 2; ++j) x.emplace(raii{j}, raii{j});
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(num_elements * 2));
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+using throwing_map_type =
+  boost::unordered::concurrent_flat_map<raii, raii, countdown_hash>;
+using throwing_node_map_type =
+  boost::unordered::concurrent_node_map<raii, raii, countdown_hash>;
+
+throwing_map_type* test_throwing_map;
+throwing_node_map_type* test_throwing_node_map;
+
+// clang-format off
+UNORDERED_TEST(
+  insert_through_rehashes,
+  ((test_map)(test_node_map)(test_set)(test_node_set)))
+
+UNORDERED_TEST(
+  throwing_hash_during_rehash,
+  ((test_throwing_map)(test_throwing_node_map)))
+// clang-format on
+
+RUN_TESTS()
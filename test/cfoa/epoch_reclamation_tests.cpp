@@ -0,0 +1,279 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using node_map_type = boost::unordered::concurrent_node_map<raii, raii,
+  hasher, key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+node_map_type* test_node_map;
+
+namespace {
+  test::seed_t initialize_seed{5530871};
+
+  using boost::unordered::epoch_reclamation;
+
+  template <class X> void epoch_reclamation_construction(X*)
+  {
+    using allocator_type = typename X::allocator_type;
+
+    raii::reset_counts();
+
+    {
+      X x(epoch_reclamation, 100, hasher(1), key_equal(2), allocator_type(3));
+      BOOST_TEST(x.has_epoch_reclamation());
+      BOOST_TEST_GE(x.bucket_count(), 100u);
+      BOOST_TEST_EQ(x.hash_function(), hasher(1));
+      BOOST_TEST_EQ(x.key_eq(), key_equal(2));
+      BOOST_TEST(x.get_allocator() == allocator_type(3));
+
+      for (int i = 0; i < 1000; ++i) x.emplace(raii{i}, raii{i});
+      for (int i = 0; i < 1000; i += 2) x.erase(raii{i});
+      BOOST_TEST_EQ(x.size(), 500u);
+
+      // the reclamation mode is not propagated
+      X y(x);
+      BOOST_TEST_NOT(y.has_epoch_reclamation());
+      BOOST_TEST(y == x);
+
+      X z;
+      BOOST_TEST_NOT(z.has_epoch_reclamation());
+      z = std::move(x);
+      BOOST_TEST_NOT(z.has_epoch_reclamation());
+      BOOST_TEST_EQ(z.size(), 500u);
+
+      X w(epoch_reclamation);
+      BOOST_TEST(w.has_epoch_reclamation());
+      BOOST_TEST(w.empty());
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void slow_visitor_does_not_block_erasure(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1024;
+    std::vector<raii> keys;
+    for (int i = 0; i < n; ++i) keys.emplace_back(i);
+
+    raii::reset_counts();
+
+    {
+      X x(epoch_reclamation);
+      for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+
+      std::atomic<bool> inside{false}, erased{false};
+      std::uint32_t num_destructions = 0;
+
+      std::thread reader([&] {
+        x.cvisit(keys[0], [&](value_type const& v) {
+          num_destructions = raii::destructor;
+          inside = true;
+          while (!erased) std::this_thread::yield();
+
+          // neither the visited element nor any other retired afterwards
+          // can have been freed while the visitor runs
+          BOOST_TEST_EQ(raii::destructor, num_destructions);
+          BOOST_TEST_EQ(v.first.x_, 0);
+          BOOST_TEST_EQ(v.second.x_, 0);
+        });
+      });
+
+      while (!inside) std::this_thread::yield();
+
+      // the writer acquires the same group lock the reader found the element
+      // under
+      for (std::size_t i = 0; i < keys.size(); ++i) {
+        BOOST_TEST_EQ(x.erase(keys[i]), 1u);
+      }
+      BOOST_TEST(x.empty());
+      erased = true;
+      reader.join();
+
+      for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+      for (std::size_t i = 0; i < keys.size(); ++i) x.erase(keys[i]);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void extraction_waits_for_readers(X*)
+  {
+    using value_type = typename X::value_type;
+
+    raii::reset_counts();
+
+    {
+      X x(epoch_reclamation);
+      for (int i = 0; i < 100; ++i) x.emplace(raii{i}, raii{i});
+
+      std::atomic<bool> inside{false}, extracted{false};
+
+      std::thread reader([&] {
+        x.cvisit(raii{42}, [&](value_type const& v) {
+          inside = true;
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+          BOOST_TEST_NOT(extracted.load());
+          BOOST_TEST_EQ(v.second.x_, 42);
+        });
+      });
+
+      while (!inside) std::this_thread::yield();
+      auto nh = x.extract(raii{42});
+      extracted = true;
+      reader.join();
+
+      BOOST_TEST(!nh.empty());
+      BOOST_TEST_EQ(nh.mapped().x_, 42);
+      BOOST_TEST_EQ(x.size(), 99u);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void concurrent_erase_and_visit(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const num_keys = 256;
+    std::vector<int> ops(1024 * 16);
+    for (std::size_t i = 0; i < ops.size(); ++i) {
+      ops[i] = static_cast<int>(i);
+    }
+
+    raii::reset_counts();
+
+    {
+      X x(epoch_reclamation);
+      for (int i = 0; i < num_keys; ++i) x.emplace(raii{i}, raii{i});
+
+      std::atomic<std::size_t> num_visits{0};
+
+      thread_runner(ops, [&](boost::span<int> s) {
+        for (auto i : s) {
+          int const k = i % num_keys;
+          switch (i % 4) {
+          case 0:
+            x.erase(raii{k});
+            break;
+          case 1:
+            x.emplace(raii{k}, raii{k});
+            break;
+          default:
+            num_visits += x.cvisit(raii{k}, [&](value_type const& v) {
+              BOOST_TEST_EQ(v.first.x_, k);
+              BOOST_TEST_EQ(v.second.x_, k);
+            });
+            break;
+          }
+        }
+      });
+
+      BOOST_TEST_LE(num_visits.load(), ops.size() / 2);
+      x.cvisit_all([](value_type const& v) {
+        BOOST_TEST_EQ(v.first.x_, v.second.x_);
+      });
+
+      // exclusive access frees all retired elements
+      x.clear();
+      BOOST_TEST(x.empty());
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void concurrent_update_and_visit(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const num_keys = 16; // high contention
+    std::vector<int> ops(1024 * 16);
+    for (std::size_t i = 0; i < ops.size(); ++i) {
+      ops[i] = static_cast<int>(i);
+    }
+
+    raii::reset_counts();
+
+    {
+      X x(epoch_reclamation);
+      for (int i = 0; i < num_keys; ++i) x.emplace(raii{i}, raii{0});
+
+      std::atomic<int> num_updates{0};
+
+      thread_runner(ops, [&](boost::span<int> s) {
+        std::vector<int> last(num_keys, 0);
+        for (auto i : s) {
+          int const k = i % num_keys;
+          switch ((i / num_keys) % 4) {
+          case 0:
+            num_updates += static_cast<int>(
+              x.visit(raii{k}, [](value_type& v) { v.second.x_ += 2; }));
+            break;
+          case 1:
+            // the element exists, so this visits it
+            x.emplace_or_visit(
+              raii{k}, raii{0}, [](value_type& v) { v.second.x_ += 2; });
+            ++num_updates;
+            break;
+          default:
+            // elements are replaced rather than modified in place, so
+            // visitation sees a stable value that never goes backwards
+            x.cvisit(raii{k}, [&](value_type const& v) {
+              int const value = v.second.x_;
+              std::this_thread::yield();
+              BOOST_TEST_EQ(v.second.x_, value);
+              BOOST_TEST_EQ(value % 2, 0);
+              BOOST_TEST_GE(value, last[static_cast<std::size_t>(k)]);
+              last[static_cast<std::size_t>(k)] = value;
+            });
+            break;
+          }
+        }
+      });
+
+      int total = 0;
+      x.cvisit_all([&](value_type const& v) { total += v.second.x_; });
+      BOOST_TEST_EQ(total, 2 * num_updates.load());
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(num_keys));
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  epoch_reclamation_construction,
+  ((test_node_map)))
+
+UNORDERED_TEST(
+  slow_visitor_does_not_block_erasure,
+  ((test_node_map)))
+
+UNORDERED_TEST(
+  extraction_waits_for_readers,
+  ((test_node_map)))
+
+UNORDERED_TEST(
+  concurrent_erase_and_visit,
+  ((test_node_map)))
+
+UNORDERED_TEST(
+  concurrent_update_and_visit,
+  ((test_node_map)))
+// clang-format on
+
+RUN_TESTS()
@@ -98,6 +98,38 @@ namespace {
     }
   } transp_lvalue_eraser;
 
+  struct bulk_eraser_type
+  {
+    template <class T, class X> void operator()(std::vector<T>& values, X& x)
+    {
+      static constexpr auto value_type_cardinality = 
+        value_cardinality<typename X::value_type>::value;
+
+      std::vector<typename X::key_type> keys;
+      keys.reserve(values.size());
+      for (auto const& v : values) {
+        keys.push_back(get_key(v));
+      }
+
+      std::atomic<std::uint64_t> num_erased{0};
+      auto const old_size = x.size();
+
+      auto const old_d = +raii::destructor;
+
+      using key_type = typename X::key_type;
+      thread_runner(keys, [&num_erased, &x](boost::span<key_type> s) {
+        num_erased += x.erase(s.begin(), s.end());
+      });
+
+      BOOST_TEST_EQ(
+        raii::destructor, old_d + value_type_cardinality * old_size);
+
+      BOOST_TEST_EQ(x.size(), 0u);
+      BOOST_TEST(x.empty());
+      BOOST_TEST_EQ(num_erased, old_size);
+    }
+  } bulk_eraser;
+
   struct lvalue_eraser_if_type
   {
     template <class T, class X> void operator()(std::vector<T>& values, X& x)
@@ -464,7 +496,7 @@ UNORDERED_TEST(
   erase,
   ((map)(node_map)(set)(node_set))
   ((value_type_generator_factory)(init_type_generator_factory))
-  ((lvalue_eraser)(lvalue_eraser_if)(erase_if)(free_fn_erase_if)(erase_if_exec_policy))
+  ((lvalue_eraser)(bulk_eraser)(lvalue_eraser_if)(erase_if)(free_fn_erase_if)(erase_if_exec_policy))
   ((default_generator)(sequential)(limited_range)))
 
 UNORDERED_TEST(
@@ -0,0 +1,236 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include <boost/unordered/work_stealing_executor.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using test::default_generator;
+using test::limited_range;
+using test::sequential;
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+using node_map_type = boost::unordered::concurrent_node_map<raii, raii,
+  hasher, key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+using set_type = boost::unordered::concurrent_flat_set<raii, hasher,
+  key_equal, stateful_allocator<raii> >;
+using node_set_type = boost::unordered::concurrent_node_set<raii, hasher,
+  key_equal, stateful_allocator<raii> >;
+
+map_type* test_map;
+node_map_type* test_node_map;
+set_type* test_set;
+node_set_type* test_node_set;
+
+namespace {
+  test::seed_t initialize_seed{4416083};
+
+  using boost::unordered::work_stealing_executor;
+
+  void check_coverage(work_stealing_executor& ex, std::size_t n)
+  {
+    std::vector<std::atomic<int> > hits(n);
+    for (auto& h : hits) h.store(0);
+
+    ex.for_each_chunk(n, [&](std::size_t i, std::size_t j) {
+      BOOST_TEST_LT(i, j);
+      BOOST_TEST_LE(j, n);
+      for (; i < j; ++i) ++hits[i];
+    });
+    for (auto& h : hits) BOOST_TEST_EQ(h.load(), 1);
+
+    std::vector<int> v(n, 0);
+    ex.for_each(v.begin(), v.end(), [](int& x) { ++x; });
+    for (auto x : v) BOOST_TEST_EQ(x, 1);
+  }
+
+  void executor_coverage()
+  {
+    for (std::size_t concurrency : {1u, 2u, 4u, 7u}) {
+      work_stealing_executor ex(concurrency);
+      BOOST_TEST_EQ(ex.concurrency(), concurrency);
+
+      for (std::size_t n : {0u, 1u, 3u, 64u, 1000u, 100000u}) {
+        check_coverage(ex, n);
+      }
+    }
+
+    work_stealing_executor ex(0);
+    BOOST_TEST_EQ(ex.concurrency(), 1u);
+    BOOST_TEST_GE(work_stealing_executor::default_concurrency(), 1u);
+  }
+
+  void executor_all_of()
+  {
+    work_stealing_executor ex(4);
+
+    std::vector<int> v(100000);
+    for (std::size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(i);
+
+    BOOST_TEST(ex.all_of(v.begin(), v.end(), [](int x) { return x >= 0; }));
+    BOOST_TEST(ex.all_of(v.begin(), v.begin(), [](int) { return false; }));
+
+    // remaining chunks are not handed out once some element fails the test
+    std::atomic<std::size_t> num_visited{0};
+    BOOST_TEST_NOT(ex.all_of(v.begin(), v.end(), [&](int x) {
+      ++num_visited;
+      return x < 10;
+    }));
+    BOOST_TEST_LT(num_visited.load(), v.size());
+  }
+
+  void executor_exceptions()
+  {
+    work_stealing_executor ex(4);
+
+    std::vector<int> v(10000, 0);
+    BOOST_TEST_THROWS(ex.for_each(v.begin(), v.end(),
+                        [&](int& x) {
+                          if (&x == &v[5000]) throw std::runtime_error("");
+                        }),
+      std::runtime_error);
+
+    // the executor is still usable after an exception
+    check_coverage(ex, 10000);
+  }
+
+  void executor_nested_and_concurrent_jobs()
+  {
+    work_stealing_executor ex(4);
+
+    // jobs submitted from within a running job are executed inline
+    std::atomic<std::size_t> total{0};
+    ex.for_each_chunk(64, [&](std::size_t i, std::size_t j) {
+      for (; i < j; ++i) {
+        ex.for_each_chunk(100, [&](std::size_t k, std::size_t l) {
+          total += l - k;
+        });
+      }
+    });
+    BOOST_TEST_EQ(total.load(), 6400u);
+
+    // jobs submitted from different threads are serialized
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < 16; ++i) check_coverage(ex, 5000);
+      });
+    }
+    for (auto& th : threads) th.join();
+  }
+
+  template <class X, class GF>
+  void executor_visitation(X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    // concurrent_flat_set visit is always const access
+    using arg_type = typename std::conditional<
+      std::is_same<typename X::key_type, typename X::value_type>::value,
+      typename X::value_type const, typename X::value_type>::type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+
+    raii::reset_counts();
+
+    {
+      work_stealing_executor ex(4);
+      X x(values.begin(), values.end());
+      X const& y = x;
+
+      std::atomic<std::size_t> num_visits{0};
+      x.visit_all(ex, [&](arg_type& v) {
+        BOOST_TEST(reference_cont.contains(get_key(v)));
+        BOOST_TEST_EQ(v, *reference_cont.find(get_key(v)));
+        ++num_visits;
+      });
+      BOOST_TEST_EQ(num_visits.load(), reference_cont.size());
+
+      num_visits = 0;
+      y.visit_all(ex, [&](value_type const&) { ++num_visits; });
+      BOOST_TEST_EQ(num_visits.load(), reference_cont.size());
+
+      num_visits = 0;
+      x.cvisit_all(ex, [&](value_type const&) { ++num_visits; });
+      BOOST_TEST_EQ(num_visits.load(), reference_cont.size());
+
+      BOOST_TEST(x.visit_while(ex, [](arg_type&) { return true; }));
+      BOOST_TEST(y.visit_while(ex, [](value_type const&) { return true; }));
+
+      num_visits = 0;
+      BOOST_TEST_NOT(x.cvisit_while(ex, [&](value_type const&) {
+        return ++num_visits < 10;
+      }));
+      BOOST_TEST_LT(num_visits.load(), reference_cont.size());
+
+      std::size_t expected = 0;
+      for (auto const& v : reference_cont) {
+        if (get_key(v).x_ % 2) ++expected;
+      }
+      x.erase_if(ex, [](arg_type& v) { return get_key(v).x_ % 2 == 0; });
+      BOOST_TEST_EQ(x.size(), expected);
+      x.cvisit_all(
+        ex, [](value_type const& v) { BOOST_TEST_EQ(get_key(v).x_ % 2, 1); });
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void executor_empty_container(X*)
+  {
+    using value_type = typename X::value_type;
+
+    work_stealing_executor ex(4);
+    X x;
+    x.cvisit_all(ex, [](value_type const&) {
+      BOOST_ERROR("visitation on an empty container");
+    });
+    BOOST_TEST(x.cvisit_while(ex, [](value_type const&) { return false; }));
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_AUTO_TEST (executor_coverage_tests) {
+  executor_coverage();
+}
+
+UNORDERED_AUTO_TEST (executor_all_of_tests) {
+  executor_all_of();
+}
+
+UNORDERED_AUTO_TEST (executor_exceptions_tests) {
+  executor_exceptions();
+}
+
+UNORDERED_AUTO_TEST (executor_nested_and_concurrent_jobs_tests) {
+  executor_nested_and_concurrent_jobs();
+}
+
+UNORDERED_TEST(
+  executor_visitation,
+  ((test_map)(test_node_map)(test_set)(test_node_set))
+  ((value_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+
+UNORDERED_TEST(
+  executor_empty_container,
+  ((test_map)(test_node_map)(test_set)(test_node_set)))
+// clang-format on
+
+RUN_TESTS()
@@ -0,0 +1,339 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using test::default_generator;
+using test::limited_range;
+using test::sequential;
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+map_type* test_map;
+
+namespace {
+  test::seed_t initialize_seed{3095117};
+
+  template <class X> void fixed_capacity_no_insert(X*)
+  {
+    using allocator_type = typename X::allocator_type;
+
+    X x(boost::unordered::fixed_capacity, 1000, hasher(1), key_equal(2),
+      allocator_type(3));
+    BOOST_TEST(x.has_fixed_capacity());
+    BOOST_TEST_GE(x.max_load(), 1000u);
+
+    auto const bc = x.bucket_count();
+    x.rehash(10 * bc);
+    BOOST_TEST_EQ(x.bucket_count(), bc);
+    x.reserve(10 * bc);
+    BOOST_TEST_EQ(x.bucket_count(), bc);
+
+    X y(x);
+    BOOST_TEST(!y.has_fixed_capacity());
+
+    X z(0);
+    BOOST_TEST(!z.has_fixed_capacity());
+
+    X w(boost::unordered::fixed_capacity, 0);
+    BOOST_TEST(w.has_fixed_capacity());
+    BOOST_TEST_EQ(w.bucket_count(), 0u);
+    BOOST_TEST(!w.insert({raii{0}, raii{0}}));
+    BOOST_TEST(!w.emplace_or_visit(raii{0}, raii{0}, [](map_type::value_type&) {
+      BOOST_ERROR("visitation on a full container");
+    }));
+    BOOST_TEST(w.empty());
+  }
+
+  template <class X, class GF>
+  void insert_until_full(X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+    using T = span_value_type<decltype(values)>;
+
+    raii::reset_counts();
+
+    {
+      std::size_t const n = reference_cont.size() / 2;
+
+      X x(boost::unordered::fixed_capacity, n);
+      auto const bc = x.bucket_count();
+      auto const ml = x.max_load();
+
+      std::atomic<std::size_t> num_inserts{0};
+      thread_runner(values, [&x, &num_inserts](boost::span<T> s) {
+        for (auto const& v : s) {
+          if (x.insert(v)) ++num_inserts;
+        }
+      });
+
+      BOOST_TEST_EQ(x.bucket_count(), bc);
+      BOOST_TEST_EQ(x.max_load(), ml);
+      BOOST_TEST_EQ(x.size(), num_inserts);
+      BOOST_TEST_GE(x.size(), n);
+      BOOST_TEST_LE(x.size(), ml);
+
+      x.visit_all([&](value_type const& v) {
+        BOOST_TEST(reference_cont.contains(get_key(v)));
+      });
+
+      // erasure does not reduce the capacity available
+
+      for (int i = 0; i < 4; ++i) {
+        std::atomic<std::size_t> num_erased{0};
+        thread_runner(values, [&x, &num_erased](boost::span<T> s) {
+          for (auto const& v : s) {
+            num_erased += x.erase(get_key(v));
+          }
+        });
+        BOOST_TEST_EQ(num_erased, num_inserts);
+        BOOST_TEST(x.empty());
+        BOOST_TEST_EQ(x.max_load(), ml);
+
+        num_inserts = 0;
+        thread_runner(values, [&x, &num_inserts](boost::span<T> s) {
+          num_inserts += x.insert(s.begin(), s.end());
+        });
+        BOOST_TEST_EQ(x.size(), num_inserts);
+        BOOST_TEST_GE(x.size(), n);
+        BOOST_TEST_LE(x.size(), ml);
+        BOOST_TEST_EQ(x.bucket_count(), bc);
+      }
+
+      thread_runner(values, [&x](boost::span<T> s) {
+        (void)s;
+        x.clear();
+      });
+      BOOST_TEST(x.empty());
+      BOOST_TEST_EQ(x.max_load(), ml);
+      BOOST_TEST_EQ(x.bucket_count(), bc);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void fixed_capacity_swap_and_move(X*)
+  {
+    raii::reset_counts();
+
+    {
+      X x(boost::unordered::fixed_capacity, 100);
+      X y(1000);
+
+      for (int i = 0; i < 50; ++i) {
+        x.insert({raii{i}, raii{i}});
+        y.insert({raii{i}, raii{i}});
+      }
+
+      auto const bcx = x.bucket_count();
+      auto const bcy = y.bucket_count();
+
+      // fixed-capacity mode goes with the bucket array
+
+      x.swap(y);
+      BOOST_TEST(!x.has_fixed_capacity());
+      BOOST_TEST(y.has_fixed_capacity());
+      BOOST_TEST_EQ(x.bucket_count(), bcy);
+      BOOST_TEST_EQ(y.bucket_count(), bcx);
+
+      auto const ml = y.max_load();
+      for (int i = 0; i < 50; ++i) y.erase(raii{i});
+      BOOST_TEST(y.empty());
+      BOOST_TEST_EQ(y.max_load(), ml);
+
+      y.rehash(10 * bcx);
+      BOOST_TEST_EQ(y.bucket_count(), bcx);
+      x.rehash(10 * bcy);
+      BOOST_TEST_GT(x.bucket_count(), bcy);
+
+      X z;
+      z = std::move(y);
+      BOOST_TEST(z.has_fixed_capacity());
+      BOOST_TEST(!y.has_fixed_capacity());
+      BOOST_TEST_EQ(z.bucket_count(), bcx);
+
+      X w(boost::unordered::fixed_capacity, 100);
+      w = z;
+      BOOST_TEST(w.has_fixed_capacity());
+      z = x;
+      BOOST_TEST(z.has_fixed_capacity());
+      BOOST_TEST(z == x);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X, class GF>
+  void copy_while_inserting(X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+    using T = span_value_type<decltype(values)>;
+
+    raii::reset_counts();
+
+    {
+      // container-wide operations are still thread-safe in fixed-capacity
+      // mode, and see a consistent state of the table
+
+      X x(boost::unordered::fixed_capacity, reference_cont.size());
+      std::atomic<bool> done{false};
+
+      std::thread t([&] {
+        std::size_t last_size = 0;
+        do {
+          X y(x);
+          BOOST_TEST(!y.has_fixed_capacity());
+          BOOST_TEST_GE(y.size(), last_size);
+          last_size = y.size();
+
+          std::size_t n = 0;
+          y.cvisit_all([&](value_type const& v) {
+            BOOST_TEST(reference_cont.contains(get_key(v)));
+            ++n;
+          });
+          BOOST_TEST_EQ(n, y.size());
+
+          bool eq = (x == y);
+          (void)eq;
+        } while (!done.load());
+      });
+
+      thread_runner(values, [&x](boost::span<T> s) {
+        for (auto const& v : s) x.insert(v);
+      });
+      done.store(true);
+      t.join();
+
+      BOOST_TEST_EQ(x.size(), reference_cont.size());
+      X y(x);
+      BOOST_TEST(x == y);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X>
+  std::size_t nested_visit(std::unique_ptr<X>* ts, std::size_t n, int k)
+  {
+    if (n == 0) return 1;
+
+    std::size_t res = 0;
+    ts[0]->cvisit(raii{k}, [&](typename X::value_type const&) {
+      res = nested_visit(ts + 1, n - 1, k);
+    });
+    return res;
+  }
+
+  template <class X> void nested_access_while_swapping(X*)
+  {
+    int const num_keys = 100;
+    std::size_t const num_tables = 6;
+    int const num_rounds = 200;
+
+    raii::reset_counts();
+
+    {
+      // access nested deeper than quiescence records allow falls back to
+      // locking, and fixed-capacity mode can move between tables while
+      // other threads access them
+
+      std::unique_ptr<X> ts[num_tables];
+      for (std::size_t i = 0; i < num_tables; ++i) {
+        if (i % 2 == 0) {
+          ts[i].reset(new X(boost::unordered::fixed_capacity, 2 * num_keys));
+        } else {
+          ts[i].reset(new X());
+        }
+        for (int k = 0; k < num_keys; ++k) ts[i]->insert({raii{k}, raii{k}});
+      }
+
+      std::atomic<bool> done{false};
+      std::thread t([&] {
+        for (int n = 0; n < num_rounds; ++n) {
+          auto& x = *ts[static_cast<std::size_t>(n) % num_tables];
+          bool fixed = x.has_fixed_capacity();
+          X y(x);
+          x.swap(y);
+          BOOST_TEST_EQ(y.has_fixed_capacity(), fixed);
+          x.swap(y);
+          BOOST_TEST_EQ(x.has_fixed_capacity(), fixed);
+        }
+        done.store(true);
+      });
+
+      std::vector<std::thread> ths;
+      for (std::size_t i = 0; i < num_threads; ++i) {
+        ths.emplace_back([&, i] {
+          int k = num_keys + static_cast<int>(i);
+          do {
+            BOOST_TEST_EQ(nested_visit(ts, num_tables, k % num_keys), 1u);
+            ts[static_cast<std::size_t>(k) % num_tables]->insert(
+              {raii{k}, raii{k}});
+            k += static_cast<int>(num_threads);
+          } while (!done.load());
+        });
+      }
+
+      t.join();
+      for (auto& th : ths) th.join();
+
+      for (int k = 0; k < num_keys; ++k) {
+        BOOST_TEST_EQ(nested_visit(ts, num_tables, k), 1u);
+      }
+      for (std::size_t i = 0; i < num_tables; i += 2) {
+        BOOST_TEST(ts[i]->has_fixed_capacity());
+        BOOST_TEST_LE(ts[i]->size(), ts[i]->max_load());
+      }
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  fixed_capacity_no_insert,
+  ((test_map)))
+
+UNORDERED_TEST(
+  insert_until_full,
+  ((test_map))
+  ((value_type_generator_factory)(init_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+
+UNORDERED_TEST(
+  fixed_capacity_swap_and_move,
+  ((test_map)))
+
+UNORDERED_TEST(
+  copy_while_inserting,
+  ((test_map))
+  ((value_type_generator_factory))
+  ((default_generator)(limited_range)))
+
+UNORDERED_TEST(
+  nested_access_while_swapping,
+  ((test_map)))
+// clang-format on
+
+RUN_TESTS()
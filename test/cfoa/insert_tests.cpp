@@ -175,6 +175,26 @@ namespace {
     }
   } iterator_range_inserter;
 
+  struct bulk_iterator_range_inserter_type
+  {
+    template <class T, class X> void operator()(std::vector<T>& values, X& x)
+    {
+      static constexpr auto value_type_cardinality = 
+        value_cardinality<typename X::value_type>::value;
+
+      std::atomic<std::uint64_t> num_inserts{0};
+      thread_runner(values, [&x, &num_inserts](boost::span<T> s) {
+        num_inserts += x.insert(s.begin(), s.begin() + s.size() / 2);
+        num_inserts += x.insert(s.begin(), s.end());
+      });
+      BOOST_TEST_EQ(num_inserts, x.size());
+      BOOST_TEST_EQ(
+        raii::copy_constructor, value_type_cardinality * x.size());
+      BOOST_TEST_EQ(raii::copy_assignment, 0u);
+      BOOST_TEST_EQ(raii::move_assignment, 0u);
+    }
+  } bulk_iterator_range_inserter;
+
 #if !defined(BOOST_UNORDERED_NO_RANGES)
   struct range_inserter_type
   {
@@ -1016,6 +1036,38 @@ namespace {
     }
   } iterator_range_insert_or_visit;
 
+  struct bulk_iterator_range_insert_or_visit_type
+  {
+    template <class T, class X> void operator()(std::vector<T>& values, X& x)
+    {
+      static constexpr auto value_type_cardinality = 
+        value_cardinality<typename X::value_type>::value;
+
+      // concurrent_flat_set visit is always const access
+      using arg_type = typename std::conditional<
+        std::is_same<typename X::key_type, typename X::value_type>::value,
+        typename X::value_type const,
+        typename X::value_type
+      >::type;
+
+      std::atomic<std::uint64_t> num_invokes{0};
+      thread_runner(values, [&x, &num_invokes](boost::span<T> s) {
+        BOOST_TEST_EQ(x.insert_or_visit(s.begin(), s.end(),
+                        [&num_invokes](arg_type& v) {
+                          (void)v;
+                          ++num_invokes;
+                        }),
+          s.size());
+      });
+
+      BOOST_TEST_EQ(num_invokes, values.size() - x.size());
+      BOOST_TEST_EQ(
+        raii::copy_constructor, value_type_cardinality * x.size());
+      BOOST_TEST_EQ(raii::copy_assignment, 0u);
+      BOOST_TEST_EQ(raii::move_assignment, 0u);
+    }
+  } bulk_iterator_range_insert_or_visit;
+
 #if !defined(BOOST_UNORDERED_NO_RANGES)
   struct insert_range_or_visit_type
   {
@@ -1493,10 +1545,11 @@ UNORDERED_TEST(
    (set)(fancy_set)(node_set)(fancy_node_set))
   ((value_type_generator_factory)(init_type_generator_factory))
   ((lvalue_inserter)(rvalue_inserter)(iterator_range_inserter)
-   RANGE_INSERTER (norehash_lvalue_inserter)(norehash_rvalue_inserter)
+   (bulk_iterator_range_inserter) RANGE_INSERTER (norehash_lvalue_inserter)(norehash_rvalue_inserter)
    (lvalue_insert_or_cvisit)(lvalue_insert_or_visit)
    (rvalue_insert_or_cvisit)(rvalue_insert_or_visit)
    (iterator_range_insert_or_cvisit)(iterator_range_insert_or_visit)
+   (bulk_iterator_range_insert_or_visit)
    INSERT_RANGE_OR_CVISIT INSERT_RANGE_OR_VISIT )
   ((default_generator)(sequential)(limited_range)))
 
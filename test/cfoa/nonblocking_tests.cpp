@@ -0,0 +1,215 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+
+#include <atomic>
+#include <thread>
+
+using test::default_generator;
+using test::limited_range;
+using test::sequential;
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+map_type* test_map;
+
+namespace {
+  test::seed_t initialize_seed{3602957};
+
+  using boost::unordered::nonblocking;
+  using boost::unordered::nonblocking_result;
+
+  template <class X> void nonblocking_operations(X*)
+  {
+    using value_type = typename X::value_type;
+
+    raii::reset_counts();
+
+    {
+      X x;
+
+      // rehashing is blocking, so insertion into a full table would block
+      BOOST_TEST(x.insert_or_visit(nonblocking, {raii{0}, raii{0}},
+                   [](value_type&) {}) == nonblocking_result::would_block);
+      BOOST_TEST(x.empty());
+
+      x.reserve(1024);
+      for (int i = 0; i < 1024; ++i) {
+        BOOST_TEST(x.insert_or_visit(nonblocking, {raii{i}, raii{i}},
+                     [](value_type&) {}) == nonblocking_result::inserted);
+      }
+      BOOST_TEST_EQ(x.size(), 1024u);
+
+      BOOST_TEST(x.insert_or_visit(nonblocking, {raii{0}, raii{0}},
+                   [](value_type& v) { ++v.second.x_; }) ==
+                 nonblocking_result::found);
+      value_type const v{raii{1}, raii{1}};
+      BOOST_TEST(x.insert_or_cvisit(nonblocking, v, [](value_type const& w) {
+        BOOST_TEST_EQ(w.second.x_, 1);
+      }) == nonblocking_result::found);
+      BOOST_TEST(x.emplace_or_visit(nonblocking, raii{2}, raii{2},
+                   [](value_type& w) { ++w.second.x_; }) ==
+                 nonblocking_result::found);
+      BOOST_TEST(x.emplace_or_cvisit(nonblocking, raii{-1}, raii{-1},
+                   [](value_type const&) {
+                     BOOST_ERROR("visitation on insertion");
+                   }) == nonblocking_result::inserted);
+
+      BOOST_TEST(x.visit(nonblocking, raii{0}, [](value_type& w) {
+        BOOST_TEST_EQ(w.second.x_, 1);
+      }) == nonblocking_result::found);
+      BOOST_TEST(x.cvisit(nonblocking, raii{2}, [](value_type const& w) {
+        BOOST_TEST_EQ(w.second.x_, 3);
+      }) == nonblocking_result::found);
+      BOOST_TEST(x.visit(nonblocking, raii{5000}, [](value_type&) {
+        BOOST_ERROR("visitation of a non-existent element");
+      }) == nonblocking_result::not_found);
+
+      BOOST_TEST(
+        x.erase(nonblocking, raii{-1}) == nonblocking_result::found);
+      BOOST_TEST(
+        x.erase(nonblocking, raii{-1}) == nonblocking_result::not_found);
+      BOOST_TEST_EQ(x.size(), 1024u);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void fixed_capacity_nonblocking_insert(X*)
+  {
+    using value_type = typename X::value_type;
+
+    X x(boost::unordered::fixed_capacity, 1000);
+    auto const capacity = x.max_load();
+
+    for (int i = 0; i < static_cast<int>(capacity); ++i) {
+      BOOST_TEST(x.emplace_or_visit(nonblocking, raii{i}, raii{i},
+                   [](value_type&) {}) == nonblocking_result::inserted);
+    }
+
+    // a full fixed-capacity container never blocks on insertion
+    BOOST_TEST(x.emplace_or_visit(nonblocking, raii{-1}, raii{-1},
+                 [](value_type&) {}) == nonblocking_result::full);
+    BOOST_TEST(x.insert_or_cvisit(nonblocking, value_type{raii{-1}, raii{-1}},
+                 [](value_type const&) {}) == nonblocking_result::full);
+    BOOST_TEST(x.emplace_or_visit(nonblocking, raii{0}, raii{0},
+                 [](value_type&) {}) == nonblocking_result::found);
+    BOOST_TEST_EQ(x.size(), capacity);
+  }
+
+  template <class X> void would_block(X*)
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+    x.reserve(1024);
+    for (int i = 0; i < 1024; ++i) x.emplace(raii{i}, raii{i});
+
+    // hold the group of element 0 exclusively from another thread
+
+    std::atomic<bool> visiting{false}, done{false};
+    std::thread th([&] {
+      x.visit(raii{0}, [&](value_type&) {
+        visiting.store(true);
+        while (!done.load()) std::this_thread::yield();
+      });
+    });
+    while (!visiting.load()) std::this_thread::yield();
+
+    BOOST_TEST(x.visit(nonblocking, raii{0}, [](value_type&) {
+      BOOST_ERROR("visitation of a locked element");
+    }) == nonblocking_result::would_block);
+    BOOST_TEST(x.cvisit(nonblocking, raii{0}, [](value_type const&) {
+      BOOST_ERROR("visitation of a locked element");
+    }) == nonblocking_result::would_block);
+    BOOST_TEST(x.insert_or_visit(nonblocking, {raii{0}, raii{0}},
+                 [](value_type&) {
+                   BOOST_ERROR("visitation of a locked element");
+                 }) == nonblocking_result::would_block);
+    BOOST_TEST(
+      x.erase(nonblocking, raii{0}) == nonblocking_result::would_block);
+
+    done.store(true);
+    th.join();
+
+    BOOST_TEST(x.erase(nonblocking, raii{0}) == nonblocking_result::found);
+  }
+
+  template <class X, class GF>
+  void concurrent_nonblocking_insert(
+    X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+    using T = span_value_type<decltype(values)>;
+
+    raii::reset_counts();
+
+    {
+      std::atomic<std::size_t> num_inserted{0};
+      std::atomic<std::size_t> num_blocked{0};
+
+      X x;
+      x.reserve(values.size());
+
+      thread_runner(values, [&](boost::span<T> s) {
+        for (auto const& v : s) {
+          for (;;) {
+            auto res = x.insert_or_visit(nonblocking, v, [](value_type&) {});
+            if (res == nonblocking_result::inserted) ++num_inserted;
+            if (res != nonblocking_result::would_block) break;
+            ++num_blocked;
+            std::this_thread::yield();
+          }
+          for (;;) {
+            auto res = x.cvisit(nonblocking, get_key(v),
+              [&](value_type const& w) { BOOST_TEST(get_key(w) == get_key(v)); });
+            BOOST_TEST(res != nonblocking_result::not_found);
+            if (res != nonblocking_result::would_block) break;
+            ++num_blocked;
+            std::this_thread::yield();
+          }
+        }
+      });
+
+      BOOST_TEST_EQ(num_inserted, reference_cont.size());
+      BOOST_TEST_EQ(x.size(), reference_cont.size());
+      test_fuzzy_matches_reference(x, reference_cont, rg);
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  nonblocking_operations,
+  ((test_map)))
+
+UNORDERED_TEST(
+  fixed_capacity_nonblocking_insert,
+  ((test_map)))
+
+UNORDERED_TEST(
+  would_block,
+  ((test_map)))
+
+UNORDERED_TEST(
+  concurrent_nonblocking_insert,
+  ((test_map))
+  ((value_type_generator_factory)(init_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+// clang-format on
+
+RUN_TESTS()
@@ -0,0 +1,179 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+
+#include <atomic>
+#include <vector>
+
+std::atomic<std::size_t> num_allocations{0};
+
+template <class T> struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() = default;
+  template <class U> counting_allocator(counting_allocator<U> const&) {}
+
+  T* allocate(std::size_t n)
+  {
+    ++num_allocations;
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t) { ::operator delete(p); }
+
+  bool operator==(counting_allocator const&) const { return true; }
+  bool operator!=(counting_allocator const&) const { return false; }
+};
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii,
+  boost::hash<raii>, std::equal_to<raii>,
+  counting_allocator<std::pair<raii const, raii> > >;
+using set_type = boost::unordered::concurrent_flat_set<raii,
+  boost::hash<raii>, std::equal_to<raii>, counting_allocator<raii> >;
+using node_map_type = boost::unordered::concurrent_node_map<raii, raii>;
+using node_set_type = boost::unordered::concurrent_node_set<raii>;
+
+map_type* test_map;
+set_type* test_set;
+node_map_type* test_node_map;
+node_set_type* test_node_set;
+
+namespace {
+  test::seed_t initialize_seed{2290417};
+
+  raii make_value(raii*, int k) { return raii{k}; }
+
+  template <class Value> Value make_value(Value*, int k)
+  {
+    return {raii{k}, raii{k}};
+  }
+
+  template <class X> void preallocation_threshold_setting(X*)
+  {
+    X x;
+    BOOST_TEST_EQ(x.preallocation_threshold(), 1.0f);
+    x.preallocation_threshold(0.75f);
+    BOOST_TEST_EQ(x.preallocation_threshold(), 0.75f);
+  }
+
+  void fixed_capacity_preallocation_threshold()
+  {
+    map_type x(boost::unordered::fixed_capacity, 1000);
+    x.preallocation_threshold(0.5f);
+    BOOST_TEST_EQ(x.preallocation_threshold(), 1.0f);
+  }
+
+  template <class X> void arrays_preallocated_before_rehash(X*)
+  {
+    using value_type = typename X::value_type;
+    auto make = [](int k) {
+      return make_value(static_cast<value_type*>(nullptr), k);
+    };
+
+    raii::reset_counts();
+
+    {
+      X x;
+      x.preallocation_threshold(0.75f);
+
+      int i = 0;
+      while (x.bucket_count() < 1000) x.insert(make(i++));
+
+      auto bucket_count = x.bucket_count();
+      auto max_load = x.max_load();
+      auto n = num_allocations.load();
+      for (; (x.size() + 1) * 4 < max_load * 3; ++i) x.insert(make(i));
+      BOOST_TEST_EQ(num_allocations.load(), n);
+
+      // crossing the threshold allocates the next arrays
+      x.insert(make(i++));
+      BOOST_TEST_GT(num_allocations.load(), n);
+      BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+
+      // rehashing uses the preallocated arrays
+      n = num_allocations.load();
+      for (; x.size() < max_load; ++i) x.insert(make(i));
+      BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+      x.insert(make(i++));
+      BOOST_TEST_GT(x.bucket_count(), bucket_count);
+      BOOST_TEST_EQ(num_allocations.load(), n);
+
+      for (int j = 0; j < i; ++j) BOOST_TEST(x.contains(raii{j}));
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(i));
+
+      // preallocated arrays not matching the growth size are discarded
+      x.reserve(x.size() * 4);
+      for (int j = i; j < i + 1000; ++j) x.insert(make(j));
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(i + 1000));
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void concurrent_insertion_with_preallocation(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1024 * 64;
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[static_cast<std::size_t>(i)] = i;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      x.preallocation_threshold(0.8f);
+
+      thread_runner(keys, [&](boost::span<int> s) {
+        for (auto k : s) {
+          x.insert(make_value(static_cast<value_type*>(nullptr), k));
+        }
+      });
+
+      BOOST_TEST_EQ(x.size(), keys.size());
+      for (auto k : keys) BOOST_TEST(x.contains(raii{k}));
+
+      // preallocated arrays are released on assignment, swap and destruction
+      X y, z;
+      y.preallocation_threshold(0.0f);
+      y.insert(make_value(static_cast<value_type*>(nullptr), 0));
+      z.preallocation_threshold(0.0f);
+      z.insert(make_value(static_cast<value_type*>(nullptr), 1));
+      y.swap(z);
+      y = x;
+      BOOST_TEST_EQ(y.size(), keys.size());
+      z = std::move(x);
+      BOOST_TEST_EQ(z.size(), keys.size());
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  preallocation_threshold_setting,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+
+UNORDERED_AUTO_TEST (fixed_capacity_preallocation_threshold_tests) {
+  fixed_capacity_preallocation_threshold();
+}
+
+UNORDERED_TEST(
+  arrays_preallocated_before_rehash,
+  ((test_map)(test_set)))
+
+UNORDERED_TEST(
+  concurrent_insertion_with_preallocation,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+// clang-format on
+
+RUN_TESTS()
@@ -0,0 +1,255 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/sharded_flat_map.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using sharded_map_type = boost::unordered::sharded_flat_map<raii, raii,
+  hasher, key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+sharded_map_type* test_sharded_map;
+
+namespace {
+  test::seed_t initialize_seed{6021743};
+
+  using boost::unordered::cross_shard_reads;
+
+  template <class X> void sharded_construction(X*)
+  {
+    using allocator_type = typename X::allocator_type;
+
+    for (std::size_t n : {0u, 1u, 3u, 8u, 17u}) {
+      X x(n, hasher(1), key_equal(2), allocator_type(3));
+      // rounded up to the next power of two
+      BOOST_TEST_EQ(x.shard_count() & (x.shard_count() - 1), 0u);
+      if (n > 1) {
+        BOOST_TEST_GE(x.shard_count(), n);
+        BOOST_TEST_LT(x.shard_count(), 2 * n);
+      } else {
+        BOOST_TEST_EQ(x.shard_count(), 1u);
+      }
+      BOOST_TEST_NOT(x.has_cross_shard_reads());
+      BOOST_TEST(x.empty());
+      BOOST_TEST_EQ(x.hash_function(), hasher(1));
+      BOOST_TEST_EQ(x.key_eq(), key_equal(2));
+      BOOST_TEST(x.get_allocator() == allocator_type(3));
+      for (std::size_t i = 0; i < x.shard_count(); ++i) {
+        BOOST_TEST(x.shard(i).get_allocator() == allocator_type(3));
+      }
+    }
+
+    X y(cross_shard_reads, 4);
+    BOOST_TEST(y.has_cross_shard_reads());
+    BOOST_TEST_EQ(y.shard_count(), 4u);
+  }
+
+  template <class X> void sharded_routing(X*)
+  {
+    int const n = 1024 * 16;
+
+    raii::reset_counts();
+
+    {
+      X x(8);
+      x.reserve(n);
+      for (int i = 0; i < n; ++i) {
+        BOOST_TEST(x.try_emplace(raii{i}, i));
+      }
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+
+      // each element lives in the shard it is routed to
+      for (std::size_t i = 0; i < x.shard_count(); ++i) {
+        for (auto const& v : x.shard(i)) {
+          BOOST_TEST_EQ(x.shard_for(v.first), i);
+        }
+
+        // shards are reasonably balanced
+        BOOST_TEST_GT(x.shard(i).size(), n / 8 * 3 / 4);
+        BOOST_TEST_LT(x.shard(i).size(), n / 8 * 5 / 4);
+      }
+
+      for (int i = 0; i < n; ++i) {
+        BOOST_TEST_EQ(x.cvisit(raii{i}, [&](typename X::value_type const& v) {
+          BOOST_TEST_EQ(v.second.x_, i);
+        }),
+          1u);
+      }
+      BOOST_TEST_NOT(x.contains(raii{-1}));
+      BOOST_TEST_EQ(x.count(raii{-1}), 0u);
+
+      // memory usage adds up that of the shards plus the shard holders, with
+      // one lock per shard
+      auto mu = x.memory_usage();
+      std::size_t total = mu.locks + mu.other;
+      for (std::size_t i = 0; i < x.shard_count(); ++i) {
+        total += x.shard(i).memory_usage().total;
+      }
+      BOOST_TEST_GT(mu.locks, 0u);
+      BOOST_TEST_EQ(mu.locks % x.shard_count(), 0u);
+      BOOST_TEST_LT(mu.locks / x.shard_count(), 64u);
+      BOOST_TEST_GT(mu.other, 0u);
+      BOOST_TEST_EQ(mu.total, total);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void sharded_modifiers(X*)
+  {
+    using init_type = typename X::init_type;
+
+    raii::reset_counts();
+
+    {
+      X x(4);
+
+      init_type const v0{raii{0}, raii{0}};
+      BOOST_TEST(x.insert(v0));
+      BOOST_TEST_NOT(x.insert(v0));
+      BOOST_TEST(x.insert(init_type{raii{1}, raii{1}}));
+      BOOST_TEST_NOT(x.try_emplace(raii{1}, 2));
+      BOOST_TEST_NOT(x.insert_or_assign(raii{1}, raii{3}));
+      BOOST_TEST(x.insert_or_assign(raii{2}, raii{2}));
+      BOOST_TEST_EQ(x.size(), 3u);
+      x.cvisit(raii{1}, [](typename X::value_type const& v) {
+        BOOST_TEST_EQ(v.second.x_, 3);
+      });
+
+      auto s = x.shard_for(raii{2});
+      auto n = x.with_shard(s, [](typename X::shard_type& m) {
+        m.emplace(raii{2}, raii{20});
+        return m.size();
+      });
+      BOOST_TEST_EQ(n, x.shard(s).size());
+
+      BOOST_TEST_EQ(x.erase(raii{0}), 1u);
+      BOOST_TEST_EQ(x.erase(raii{0}), 0u);
+      BOOST_TEST_EQ(x.size(), 2u);
+
+      x.clear();
+      BOOST_TEST(x.empty());
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void sharded_single_writer_per_shard(X*)
+  {
+    std::size_t const num_shards = 4;
+    int const n = 1024 * 16;
+
+    raii::reset_counts();
+
+    {
+      X x(cross_shard_reads, num_shards);
+      std::atomic<bool> done{false};
+      std::atomic<std::size_t> num_visits{0};
+
+      std::vector<std::thread> threads;
+
+      // one writer per shard, handling the keys routed to it
+      for (std::size_t i = 0; i < x.shard_count(); ++i) {
+        threads.emplace_back([&x, i] {
+          for (int k = 0; k < n; ++k) {
+            raii const key{k};
+            if (x.shard_for(key) != i) continue;
+            x.try_emplace(key, k);
+            if (k % 3 == 0) x.erase(key);
+          }
+        });
+      }
+
+      // readers from other threads
+      for (int j = 0; j < 2; ++j) {
+        threads.emplace_back([&] {
+          while (!done) {
+            for (int k = 0; k < n; k += 7) {
+              num_visits += x.cvisit(raii{k}, [&](typename X::value_type const& v) {
+                BOOST_TEST_EQ(v.first.x_, v.second.x_);
+                BOOST_TEST_NE(v.first.x_ % 3, 0);
+              });
+            }
+            (void)x.size();
+          }
+        });
+      }
+
+      for (std::size_t i = 0; i < x.shard_count(); ++i) threads[i].join();
+      done = true;
+      for (std::size_t i = x.shard_count(); i < threads.size(); ++i) {
+        threads[i].join();
+      }
+
+      std::size_t expected = 0;
+      for (int k = 0; k < n; ++k) {
+        if (k % 3) ++expected;
+      }
+      BOOST_TEST_EQ(x.size(), expected);
+      for (int k = 0; k < n; ++k) {
+        BOOST_TEST_EQ(x.contains(raii{k}), k % 3 != 0);
+      }
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void sharded_unsynchronized_writers(X*)
+  {
+    int const n = 1024 * 16;
+
+    raii::reset_counts();
+
+    {
+      X x(4);
+
+      std::vector<std::thread> threads;
+      for (std::size_t i = 0; i < x.shard_count(); ++i) {
+        threads.emplace_back([&x, i] {
+          auto& s = x.shard(i);
+          for (int k = 0; k < n; ++k) {
+            raii const key{k};
+            if (x.shard_for(key) == i) s.emplace(key, key);
+          }
+        });
+      }
+      for (auto& th : threads) th.join();
+
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  sharded_construction,
+  ((test_sharded_map)))
+
+UNORDERED_TEST(
+  sharded_routing,
+  ((test_sharded_map)))
+
+UNORDERED_TEST(
+  sharded_modifiers,
+  ((test_sharded_map)))
+
+UNORDERED_TEST(
+  sharded_single_writer_per_shard,
+  ((test_sharded_map)))
+
+UNORDERED_TEST(
+  sharded_unsynchronized_writers,
+  ((test_sharded_map)))
+// clang-format on
+
+RUN_TESTS()
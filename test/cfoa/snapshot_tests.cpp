@@ -0,0 +1,300 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+
+map_type* test_map;
+
+namespace {
+  test::seed_t initialize_seed{5118221};
+
+  void check_snapshot(std::vector<std::pair<int, int> >& v, int n)
+  {
+    std::sort(v.begin(), v.end());
+    BOOST_TEST_EQ(v.size(), static_cast<std::size_t>(n));
+    for (int i = 0; i < n && i < static_cast<int>(v.size()); ++i) {
+      BOOST_TEST_EQ(v[i].first, i);
+      BOOST_TEST_EQ(v[i].second, i);
+    }
+  }
+
+  template <class X> void empty_snapshot(X*)
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+    BOOST_TEST_EQ(x.cvisit_all(boost::unordered::snapshot, [](value_type const&) {
+      BOOST_ERROR("visitation on an empty container");
+    }), 0u);
+
+    x.insert({raii{0}, raii{0}});
+    x.erase(raii{0});
+    BOOST_TEST_EQ(x.cvisit_all(boost::unordered::snapshot, [](value_type const&) {
+      BOOST_ERROR("visitation on an empty container");
+    }), 0u);
+  }
+
+  template <class X> void snapshot_no_writers(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1024;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+
+      std::vector<std::pair<int, int> > v;
+      auto const num_visited = x.cvisit_all(boost::unordered::snapshot,
+        [&](value_type const& w) { v.emplace_back(w.first.x_, w.second.x_); });
+      BOOST_TEST_EQ(num_visited, x.size());
+      check_snapshot(v, n);
+
+      // nothing copied aside if no writers interfere
+      BOOST_TEST_EQ(raii::copy_constructor, 0u);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void write_while_taking_snapshot(X& x, int n)
+  {
+    using value_type = typename X::value_type;
+
+    int const num_writers = static_cast<int>(num_threads);
+    bool const fixed = x.has_fixed_capacity();
+
+    for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+
+    std::atomic<bool> start{false};
+    std::atomic<int> num_writes{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < num_writers; ++t) {
+      writers.emplace_back([&, t] {
+        while (!start.load()) std::this_thread::yield();
+        for (int i = t; i < n; i += num_writers) {
+          x.visit(raii{i}, [](value_type& w) { ++w.second.x_; });
+          x.insert({raii{n + i}, raii{n + i}});
+          x.erase(raii{i});
+          ++num_writes;
+        }
+        if (t == 0 && !fixed) {
+          x.rehash(16 * n);
+          x.clear();
+        }
+      });
+    }
+
+    // halfway through, give writers some time to interfere (without waiting
+    // indefinitely, as they may be blocked by the group being visited)
+
+    std::vector<std::pair<int, int> > v;
+    auto const num_visited = x.cvisit_all(boost::unordered::snapshot,
+      [&](value_type const& w) {
+        start.store(true);
+        v.emplace_back(w.first.x_, w.second.x_);
+        if (v.size() == static_cast<std::size_t>(n / 2)) {
+          auto const deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(1);
+          while (num_writes < n / 16 &&
+                 std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    start.store(true);
+    for (auto& th : writers) th.join();
+
+    BOOST_TEST_EQ(num_visited, static_cast<std::size_t>(n));
+    check_snapshot(v, n);
+
+    // a snapshot taken after all writes sees their results
+
+    v.clear();
+    x.cvisit_all(boost::unordered::snapshot,
+      [&](value_type const& w) { v.emplace_back(w.first.x_, w.second.x_); });
+    BOOST_TEST_EQ(v.size(), x.size());
+    for (auto const& w : v) BOOST_TEST_GE(w.first, n);
+  }
+
+  template <class X> void snapshot_with_writers(X*)
+  {
+    int const n = 1024 * 16;
+
+    raii::reset_counts();
+
+    {
+      X x(n);
+      write_while_taking_snapshot(x, n);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void fixed_capacity_snapshot_with_writers(X*)
+  {
+    int const n = 1024 * 16;
+
+    raii::reset_counts();
+
+    {
+      X x(boost::unordered::fixed_capacity, 3 * n);
+      write_while_taking_snapshot(x, n);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void concurrent_snapshots(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1024 * 4;
+
+    X x;
+    for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+
+    std::vector<std::thread> readers;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      readers.emplace_back([&] {
+        for (int j = 0; j < 4; ++j) {
+          std::vector<std::pair<int, int> > v;
+          x.cvisit_all(boost::unordered::snapshot, [&](value_type const& w) {
+            v.emplace_back(w.first.x_, w.second.x_);
+          });
+          check_snapshot(v, n);
+        }
+      });
+    }
+    for (auto& th : readers) th.join();
+  }
+
+  // Snapshots started while another thread replaces the bucket array must be
+  // sized after the array they end up visiting.
+
+  template <class X> void snapshot_while_rehashing(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1024 * 4, m = n / 16;
+
+    raii::reset_counts();
+
+    {
+      X x, y;
+      for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+      for (int i = 0; i < m; ++i) y.emplace(raii{i}, raii{i});
+
+      std::atomic<bool> done{false};
+      std::thread t([&] {
+        for (int i = 0; i < 64; ++i) {
+          x.rehash(0);
+          x.rehash(16 * n);
+          x.swap(y);
+        }
+        done.store(true);
+      });
+
+      do {
+        std::vector<std::pair<int, int> > v;
+        x.cvisit_all(boost::unordered::snapshot, [&](value_type const& w) {
+          v.emplace_back(w.first.x_, w.second.x_);
+        });
+        check_snapshot(v, v.size() == static_cast<std::size_t>(m) ? m : n);
+      } while (!done.load());
+      t.join();
+    }
+
+    check_raii_counts();
+  }
+  // Container-wide operations only reading the table (copy construction,
+  // comparison) don't need to copy aside the groups pending visitation.
+
+  template <class X> void read_only_access_during_snapshot(X*)
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1024;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      for (int i = 0; i < n; ++i) x.emplace(raii{i}, raii{i});
+
+      std::atomic<bool> start{false};
+      std::thread t([&] {
+        while (!start.load()) std::this_thread::yield();
+        X y(x);
+        BOOST_TEST(y == x);
+      });
+
+      // the reader thread blocks on the first group visited, then gets
+      // exclusive access before the snapshot goes on
+      std::vector<std::pair<int, int> > v;
+      x.cvisit_all(boost::unordered::snapshot, [&](value_type const& w) {
+        if (!start.exchange(true)) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        v.emplace_back(w.first.x_, w.second.x_);
+      });
+      t.join();
+      check_snapshot(v, n);
+
+      // only the copies of the elements made by y
+      BOOST_TEST_EQ(raii::copy_constructor, 2u * n);
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  empty_snapshot,
+  ((test_map)))
+
+UNORDERED_TEST(
+  snapshot_no_writers,
+  ((test_map)))
+
+UNORDERED_TEST(
+  snapshot_with_writers,
+  ((test_map)))
+
+UNORDERED_TEST(
+  fixed_capacity_snapshot_with_writers,
+  ((test_map)))
+
+UNORDERED_TEST(
+  concurrent_snapshots,
+  ((test_map)))
+
+UNORDERED_TEST(
+  snapshot_while_rehashing,
+  ((test_map)))
+
+UNORDERED_TEST(
+  read_only_access_during_snapshot,
+  ((test_map)))
+// clang-format on
+
+RUN_TESTS()
@@ -0,0 +1,236 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_node_set.hpp>
+
+#include <algorithm>
+#include <functional>
+
+using test::default_generator;
+using test::limited_range;
+using test::sequential;
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+using node_map_type = boost::unordered::concurrent_node_map<raii, raii,
+  hasher, key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+using set_type = boost::unordered::concurrent_flat_set<raii, hasher,
+  key_equal, stateful_allocator<raii> >;
+using node_set_type = boost::unordered::concurrent_node_set<raii, hasher,
+  key_equal, stateful_allocator<raii> >;
+
+map_type* test_map;
+node_map_type* test_node_map;
+set_type* test_set;
+node_set_type* test_node_set;
+
+using flat_map_type = boost::unordered_flat_map<raii, raii, hasher, key_equal,
+  stateful_allocator<std::pair<raii const, raii> > >;
+using node_set_nc_type =
+  boost::unordered_node_set<raii, hasher, key_equal, stateful_allocator<raii> >;
+
+flat_map_type* test_flat_map;
+node_set_nc_type* test_node_set_nc;
+
+namespace {
+  test::seed_t initialize_seed{1802557};
+
+  template <class T> struct key_as_long_long
+  {
+    long long operator()(T const& v) const { return get_key(v).x_; }
+  };
+
+  struct max_of
+  {
+    long long operator()(long long x, long long y) const
+    {
+      return (std::max)(x, y);
+    }
+  };
+
+  // init is deliberately not the identity of the reduction, so that any
+  // result taking it into account more than once is caught
+
+  long long const init = 100;
+
+  template <class X> void empty_transform_reduce(X*)
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+    BOOST_TEST_EQ(x.transform_reduce(init, std::plus<long long>(),
+                    key_as_long_long<value_type>()),
+      init);
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+    BOOST_TEST_EQ(x.transform_reduce(std::execution::par, init,
+                    std::plus<long long>(), key_as_long_long<value_type>()),
+      init);
+#endif
+    BOOST_TEST_EQ(x.transform_reduce(init, max_of(),
+                    key_as_long_long<value_type>()),
+      init);
+  }
+
+  template <class X, class GF>
+  void transform_reduce(X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+
+    long long expected_sum = init, expected_max = init;
+    for (auto const& v : reference_cont) {
+      expected_sum += get_key(v).x_;
+      expected_max = (std::max)(expected_max, (long long)get_key(v).x_);
+    }
+
+    raii::reset_counts();
+
+    {
+      X x(values.begin(), values.end());
+      key_as_long_long<value_type> transform;
+      std::size_t const num_copies = raii::copy_constructor;
+
+      BOOST_TEST_EQ(
+        x.transform_reduce(init, std::plus<long long>(), transform),
+        expected_sum);
+      BOOST_TEST_EQ(
+        x.transform_reduce(init, max_of(), transform), expected_max);
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+      BOOST_TEST_EQ(x.transform_reduce(std::execution::par, init,
+                      std::plus<long long>(), transform),
+        expected_sum);
+      BOOST_TEST_EQ(
+        x.transform_reduce(std::execution::par, init, max_of(), transform),
+        expected_max);
+      BOOST_TEST_EQ(x.transform_reduce(std::execution::seq, init,
+                      std::plus<long long>(), transform),
+        expected_sum);
+#endif
+
+      // elements are visited in place, no copies involved
+      BOOST_TEST_EQ(raii::copy_constructor, num_copies);
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X, class GF>
+  void transform_reduce_while_inserting(
+    X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    using T = span_value_type<decltype(values)>;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      key_as_long_long<value_type> transform;
+
+      thread_runner(values, [&](boost::span<T> s) {
+        long long prev = 0;
+        for (auto const& v : s) {
+          x.insert(v);
+
+          // keys in the generated values are non-negative, so the sum can
+          // only grow as elements are added
+          auto const sum =
+            x.transform_reduce(0ll, std::plus<long long>(), transform);
+          BOOST_TEST_GE(sum, prev);
+          prev = sum;
+        }
+      });
+
+      long long expected = 0;
+      x.cvisit_all([&](value_type const& v) { expected += get_key(v).x_; });
+      BOOST_TEST_EQ(
+        x.transform_reduce(0ll, std::plus<long long>(), transform), expected);
+    }
+
+    check_raii_counts();
+  }
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+  void insert_key(flat_map_type& x, int i) { x.emplace(raii{i}, raii{i}); }
+  void insert_key(node_set_nc_type& x, int i) { x.emplace(raii{i}); }
+
+  template <class X> void flat_transform_reduce(X*)
+  {
+    using value_type = typename X::value_type;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      key_as_long_long<value_type> transform;
+
+      BOOST_TEST_EQ(x.transform_reduce(std::execution::par, init,
+                      std::plus<long long>(), transform),
+        init);
+
+      long long expected = init;
+      for (int i = 0; i < 1024 * 16; ++i) {
+        insert_key(x, i);
+        expected += i;
+      }
+      for (int i = 0; i < 1024 * 16; i += 3) {
+        x.erase(raii{i});
+        expected -= i;
+      }
+
+      BOOST_TEST_EQ(x.transform_reduce(std::execution::par, init,
+                      std::plus<long long>(), transform),
+        expected);
+      BOOST_TEST_EQ(
+        x.transform_reduce(std::execution::par, init, max_of(), transform),
+        static_cast<long long>(1024 * 16 - 2));
+    }
+
+    check_raii_counts();
+  }
+#endif
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  empty_transform_reduce,
+  ((test_map)(test_node_map)(test_set)(test_node_set)))
+
+UNORDERED_TEST(
+  transform_reduce,
+  ((test_map)(test_node_map)(test_set)(test_node_set))
+  ((value_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+
+UNORDERED_TEST(
+  transform_reduce_while_inserting,
+  ((test_map)(test_node_map)(test_set)(test_node_set))
+  ((value_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+UNORDERED_TEST(
+  flat_transform_reduce,
+  ((test_flat_map)(test_node_set_nc)))
+#endif
+// clang-format on
+
+RUN_TESTS()
@@ -0,0 +1,319 @@
+// Copyright (C) 2026 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using test::default_generator;
+using test::limited_range;
+using test::sequential;
+
+using hasher = stateful_hash;
+using key_equal = stateful_key_equal;
+
+using map_type = boost::unordered::concurrent_flat_map<raii, raii, hasher,
+  key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+using node_map_type = boost::unordered::concurrent_node_map<raii, raii,
+  hasher, key_equal, stateful_allocator<std::pair<raii const, raii> > >;
+using set_type = boost::unordered::concurrent_flat_set<raii, hasher,
+  key_equal, stateful_allocator<raii> >;
+using node_set_type = boost::unordered::concurrent_node_set<raii, hasher,
+  key_equal, stateful_allocator<raii> >;
+
+map_type* test_map;
+node_map_type* test_node_map;
+set_type* test_set;
+node_set_type* test_node_set;
+
+namespace {
+  test::seed_t initialize_seed{3105529};
+
+  template <class X, class GF>
+  void with_exclusive_bulk_load(X*, GF gen_factory, test::random_generator rg)
+  {
+    using value_type = typename X::value_type;
+    using view_type = typename X::unsynchronized_view;
+
+    auto gen = gen_factory.template get<X>();
+    auto values = make_random_values(1024 * 16, [&] { return gen(rg); });
+    auto reference_cont = reference_container<X>(values.begin(), values.end());
+
+    raii::reset_counts();
+
+    {
+      X x;
+
+      auto n = x.with_exclusive([&](view_type& v) {
+        BOOST_TEST(v.empty());
+        BOOST_TEST(v.begin() == v.end());
+
+        v.reserve(values.size());
+        std::size_t num_inserted = 0;
+        for (auto const& val : values) {
+          auto r = v.insert(val);
+          BOOST_TEST(r.first != v.end());
+          BOOST_TEST_EQ(get_key(*r.first), get_key(val));
+          if (r.second) ++num_inserted;
+        }
+        BOOST_TEST_EQ(v.size(), num_inserted);
+        return num_inserted;
+      });
+      BOOST_TEST_EQ(n, reference_cont.size());
+      BOOST_TEST_EQ(x.size(), reference_cont.size());
+      test_fuzzy_matches_reference(x, reference_cont, rg);
+
+      x.with_exclusive([&](view_type& v) {
+        view_type const& cv = v;
+
+        std::size_t num_elements = 0;
+        for (auto const& val : cv) {
+          BOOST_TEST(reference_cont.contains(get_key(val)));
+          ++num_elements;
+        }
+        BOOST_TEST_EQ(num_elements, reference_cont.size());
+
+        for (auto const& val : reference_cont) {
+          BOOST_TEST(v.contains(get_key(val)));
+          BOOST_TEST_EQ(cv.count(get_key(val)), 1u);
+          auto it = cv.find(get_key(val));
+          BOOST_TEST(it != cv.end());
+          BOOST_TEST(*it == val);
+        }
+        BOOST_TEST(v.find(raii{-2}) == v.end());
+        BOOST_TEST_NOT(v.contains(raii{-2}));
+
+        // erase half of the elements by key and the other half by iterator
+        std::size_t i = 0;
+        for (auto const& val : reference_cont) {
+          if (i++ % 2) {
+            BOOST_TEST_EQ(v.erase(get_key(val)), 1u);
+          } else {
+            v.erase(v.find(get_key(val)));
+          }
+        }
+        BOOST_TEST(v.empty());
+        BOOST_TEST_EQ(v.erase(raii{-2}), 0u);
+
+        for (auto const& val : values) v.emplace(val);
+        BOOST_TEST_EQ(v.size(), reference_cont.size());
+      });
+
+      // the container is fully usable afterwards
+      test_fuzzy_matches_reference(x, reference_cont, rg);
+      x.with_exclusive([](view_type& v) { v.clear(); });
+      BOOST_TEST(x.empty());
+      for (auto const& val : values) x.insert(val);
+      BOOST_TEST_EQ(x.size(), reference_cont.size());
+      x.cvisit_all([&](value_type const& val) {
+        BOOST_TEST(reference_cont.contains(get_key(val)));
+      });
+    }
+
+    check_raii_counts();
+  }
+
+  template <class X> void with_exclusive_map_operations(X*)
+  {
+    using view_type = typename X::unsynchronized_view;
+
+    raii::reset_counts();
+
+    {
+      X x;
+
+      x.with_exclusive([](view_type& v) {
+        for (int i = 0; i < 1000; ++i) {
+          auto r = v.try_emplace(raii{i % 100}, i);
+          BOOST_TEST_EQ(r.second, i < 100);
+          r.first->second.x_ += 1;
+        }
+        BOOST_TEST_EQ(v.size(), 100u);
+
+        auto r = v.emplace(raii{5}, raii{0});
+        BOOST_TEST_NOT(r.second);
+        BOOST_TEST_EQ(r.first->second.x_, 15);
+      });
+
+      x.cvisit_all([](typename X::value_type const& v) {
+        BOOST_TEST_EQ(v.second.x_, v.first.x_ + 10);
+      });
+    }
+
+    check_raii_counts();
+  }
+
+  void with_exclusive_fixed_capacity()
+  {
+    using view_type = map_type::unsynchronized_view;
+
+    raii::reset_counts();
+
+    {
+      map_type x(boost::unordered::fixed_capacity, 100);
+      auto const capacity = x.max_load();
+      auto const bucket_count = x.bucket_count();
+
+      auto n = x.with_exclusive([](view_type& v) {
+        v.reserve(10000); // no effect
+        std::size_t num_inserted = 0;
+        for (int i = 0; i < 1000; ++i) {
+          auto r = v.emplace(raii{i}, raii{i});
+          if (r.second) {
+            ++num_inserted;
+          } else {
+            BOOST_TEST(r.first == v.end());
+          }
+        }
+        return num_inserted;
+      });
+      BOOST_TEST_EQ(n, capacity);
+      BOOST_TEST_EQ(x.size(), capacity);
+      BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+
+      x.with_exclusive([](view_type& v) {
+        std::vector<int> keys;
+        for (auto const& val : v) keys.push_back(val.first.x_);
+        for (auto k : keys) v.erase(raii{k});
+      });
+      BOOST_TEST(x.empty());
+      BOOST_TEST_EQ(x.max_load(), capacity);
+      for (int i = 0; i < 1000; ++i) x.emplace(raii{i}, raii{i});
+      BOOST_TEST_EQ(x.size(), capacity);
+    }
+
+    check_raii_counts();
+  }
+
+  // Bulk sessions interleaved with concurrent insertions from other threads:
+  // no one else accesses the table during a session.
+
+  template <class X> void with_exclusive_sessions(X& x, std::vector<int>& keys)
+  {
+    using view_type = typename X::unsynchronized_view;
+
+    int const num_sessions = 16;
+
+    std::atomic<int> num_sessions_seen{0};
+
+    thread_runner(keys, [&](boost::span<int> s) {
+      for (std::size_t i = 0; i < s.size(); ++i) {
+        x.emplace(raii{s[i]}, raii{s[i]});
+
+        if (i % (s.size() / num_sessions + 1) == 0) {
+          x.with_exclusive([&](view_type& v) {
+            auto const size = v.size();
+            std::size_t num_elements = 0;
+            for (auto it = v.cbegin(); it != v.cend(); ++it) ++num_elements;
+            BOOST_TEST_EQ(num_elements, size);
+            BOOST_TEST_EQ(v.size(), size);
+
+            auto r = v.emplace(raii{-1 - num_sessions_seen++}, raii{0});
+            BOOST_TEST(r.second);
+          });
+        }
+      }
+    });
+
+    BOOST_TEST_EQ(
+      x.size(), keys.size() + static_cast<std::size_t>(num_sessions_seen));
+  }
+
+  template <class X>
+  void with_exclusive_concurrent_with_insertions(X*)
+  {
+    int const n = 1024 * 16;
+
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[static_cast<std::size_t>(i)] = i;
+
+    raii::reset_counts();
+
+    {
+      X x;
+      with_exclusive_sessions(x, keys);
+    }
+
+    check_raii_counts();
+  }
+
+  // exclusive access is equally enforced in fixed-capacity mode
+
+  void with_exclusive_fixed_capacity_concurrent_with_insertions()
+  {
+    int const n = 1024 * 16;
+
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[static_cast<std::size_t>(i)] = i;
+
+    raii::reset_counts();
+
+    {
+      map_type x(boost::unordered::fixed_capacity, 2 * keys.size());
+      auto const bucket_count = x.bucket_count();
+      with_exclusive_sessions(x, keys);
+      BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+    }
+
+    check_raii_counts();
+  }
+
+  void with_exclusive_epoch_reclamation()
+  {
+    using view_type = node_map_type::unsynchronized_view;
+
+    raii::reset_counts();
+
+    {
+      node_map_type x(boost::unordered::epoch_reclamation);
+      x.with_exclusive([](view_type& v) {
+        for (int i = 0; i < 1000; ++i) v.emplace(raii{i}, raii{i});
+        for (int i = 0; i < 1000; i += 2) v.erase(raii{i});
+      });
+      BOOST_TEST_EQ(x.size(), 500u);
+      x.cvisit(raii{1}, [](node_map_type::value_type const& v) {
+        BOOST_TEST_EQ(v.second.x_, 1);
+      });
+    }
+
+    check_raii_counts();
+  }
+} // namespace
+
+// clang-format off
+UNORDERED_TEST(
+  with_exclusive_bulk_load,
+  ((test_map)(test_node_map)(test_set)(test_node_set))
+  ((value_type_generator_factory))
+  ((default_generator)(sequential)(limited_range)))
+
+UNORDERED_TEST(
+  with_exclusive_map_operations,
+  ((test_map)(test_node_map)))
+
+UNORDERED_AUTO_TEST (with_exclusive_fixed_capacity_tests) {
+  with_exclusive_fixed_capacity();
+}
+
+UNORDERED_TEST(
+  with_exclusive_concurrent_with_insertions,
+  ((test_map)(test_node_map)))
+
+UNORDERED_AUTO_TEST (with_exclusive_fixed_capacity_concurrent_tests) {
+  with_exclusive_fixed_capacity_concurrent_with_insertions();
+}
+
+UNORDERED_AUTO_TEST (with_exclusive_epoch_reclamation_tests) {
+  with_exclusive_epoch_reclamation();
+}
+// clang-format on
+
+RUN_TESTS()
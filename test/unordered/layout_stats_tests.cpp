@@ -0,0 +1,185 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include "../cfoa/helpers.hpp"
+
+#include <atomic>
+#include <thread>
+#else
+#include "../helpers/unordered.hpp"
+#endif
+
+#include "../helpers/test.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace {
+  struct constant_hash
+  {
+    std::size_t operator()(int) const { return 0; }
+  };
+
+  template <class T> T make_value(T*, int i) { return T(i); }
+
+  template <class K, class V>
+  std::pair<K, V> make_value(std::pair<K, V>*, int i)
+  {
+    return {i, i};
+  }
+
+  template <class X> void insert_n(X& x, int n)
+  {
+    using value_type = typename X::value_type;
+    for (int i = 0; i < n; ++i) {
+      x.insert(make_value(static_cast<value_type*>(nullptr), i));
+    }
+  }
+
+  template <class LayoutStats>
+  void check_consistency(LayoutStats const& s, std::size_t size)
+  {
+    std::size_t num_groups = 0, num_elements = 0;
+    for (std::size_t i = 0; i < s.group_occupancy.size(); ++i) {
+      num_groups += s.group_occupancy[i];
+      num_elements += i * s.group_occupancy[i];
+    }
+    BOOST_TEST_EQ(num_groups, s.num_groups);
+    BOOST_TEST_EQ(num_elements, size);
+    BOOST_TEST_LE(s.num_overflowed_groups, s.num_groups);
+    BOOST_TEST_LE(s.num_reduced_hash_collisions, size);
+    if (s.num_groups) {
+      BOOST_TEST_EQ(s.overflowed_group_ratio,
+        double(s.num_overflowed_groups) / double(s.num_groups));
+    }
+    if (size) {
+      BOOST_TEST_GE(s.max_probe_length, 1u);
+      BOOST_TEST_GE(s.average_probe_length, 1.0);
+      BOOST_TEST_LE(s.average_probe_length, double(s.max_probe_length));
+    }
+  }
+
+  template <class X> void layout_stats_good_hash(X*)
+  {
+    X x;
+    auto s = x.layout_stats();
+    BOOST_TEST_EQ(s.num_groups, 0u);
+    BOOST_TEST_EQ(s.max_probe_length, 0u);
+
+    insert_n(x, 10000);
+    s = x.layout_stats();
+    check_consistency(s, x.size());
+    BOOST_TEST_GT(s.num_groups, 0u);
+    BOOST_TEST_LT(s.average_probe_length, 1.5);
+    BOOST_TEST_LT(s.num_reduced_hash_collisions, x.size() / 4);
+
+    x.clear();
+    s = x.layout_stats();
+    check_consistency(s, 0);
+    BOOST_TEST_EQ(s.group_occupancy[0], s.num_groups);
+  }
+
+  template <class X> void layout_stats_bad_hash(X*)
+  {
+    X x;
+    insert_n(x, 200);
+    auto s = x.layout_stats();
+    check_consistency(s, x.size());
+
+    // all elements share their reduced hash and are placed along one
+    // probe sequence
+    BOOST_TEST_EQ(s.num_reduced_hash_collisions, x.size());
+    BOOST_TEST_GE(s.max_probe_length, (x.size() + 14) / 15);
+    BOOST_TEST_GE(s.num_overflowed_groups, s.max_probe_length - 1);
+    BOOST_TEST_GT(s.average_probe_length, 2.0);
+  }
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+  // layout_stats() reads keys under exclusive access, which fixed-capacity
+  // maps also honor
+
+  void layout_stats_fixed_capacity_concurrent()
+  {
+    boost::concurrent_flat_map<int, int> x(
+      boost::unordered::fixed_capacity, 1000);
+    auto const num_groups = x.layout_stats().num_groups;
+    std::atomic<bool> done{false};
+
+    std::thread t([&] {
+      for (int n = 0; n < 4; ++n) {
+        for (int i = 0; i < 1000; ++i) x.insert({i, i});
+        for (int i = 0; i < 1000; ++i) x.erase(i);
+      }
+      done.store(true);
+    });
+
+    do {
+      auto s = x.layout_stats();
+      std::size_t num_elements = 0;
+      for (std::size_t i = 0; i < s.group_occupancy.size(); ++i) {
+        num_elements += i * s.group_occupancy[i];
+      }
+      BOOST_TEST_EQ(s.num_groups, num_groups);
+      BOOST_TEST_LE(num_elements, x.max_load());
+      BOOST_TEST_LE(s.num_reduced_hash_collisions, num_elements);
+      std::this_thread::yield();
+    } while (!done.load());
+
+    t.join();
+    check_consistency(x.layout_stats(), 0);
+  }
+#endif
+} // namespace
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+template <class Hash>
+using test_map_type = boost::concurrent_flat_map<int, int, Hash>;
+template <class Hash>
+using test_set_type = boost::concurrent_flat_set<int, Hash>;
+template <class Hash>
+using test_node_map_type = boost::concurrent_node_map<int, int, Hash>;
+template <class Hash>
+using test_node_set_type = boost::concurrent_node_set<int, Hash>;
+#else
+template <class Hash>
+using test_map_type = boost::unordered_flat_map<int, int, Hash>;
+template <class Hash>
+using test_set_type = boost::unordered_flat_set<int, Hash>;
+template <class Hash>
+using test_node_map_type = boost::unordered_node_map<int, int, Hash>;
+template <class Hash>
+using test_node_set_type = boost::unordered_node_set<int, Hash>;
+#endif
+
+static test_map_type<boost::hash<int> >* test_map;
+static test_set_type<boost::hash<int> >* test_set;
+static test_node_map_type<boost::hash<int> >* test_node_map;
+static test_node_set_type<boost::hash<int> >* test_node_set;
+
+static test_map_type<constant_hash>* test_bad_map;
+static test_set_type<constant_hash>* test_bad_set;
+static test_node_map_type<constant_hash>* test_bad_node_map;
+static test_node_set_type<constant_hash>* test_bad_node_set;
+
+// clang-format off
+UNORDERED_TEST(layout_stats_good_hash,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+
+UNORDERED_TEST(layout_stats_bad_hash,
+  ((test_bad_map)(test_bad_set)(test_bad_node_map)(test_bad_node_set)))
+// clang-format on
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+UNORDERED_AUTO_TEST (layout_stats_fixed_capacity_concurrent_tests) {
+  layout_stats_fixed_capacity_concurrent();
+}
+#endif
+
+RUN_TESTS()
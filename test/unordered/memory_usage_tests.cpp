@@ -0,0 +1,225 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include "../cfoa/helpers.hpp"
+#else
+#include "../helpers/unordered.hpp"
+#endif
+
+#include "../helpers/test.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace {
+  std::size_t live_bytes = 0;
+
+  template <class T> struct byte_counting_allocator
+  {
+    using value_type = T;
+
+    byte_counting_allocator() = default;
+    template <class U>
+    byte_counting_allocator(byte_counting_allocator<U> const&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+      live_bytes += n * sizeof(T);
+      return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+      live_bytes -= n * sizeof(T);
+      std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(byte_counting_allocator const&) const { return true; }
+    bool operator!=(byte_counting_allocator const&) const { return false; }
+  };
+
+  template <class T> T make_value(T*, int i) { return T(i); }
+
+  template <class K, class V>
+  std::pair<K, V> make_value(std::pair<K, V>*, int i)
+  {
+    return {i, i};
+  }
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+  template <class X> bool is_node_based(X*) { return false; }
+
+  template <class K, class V, class H, class P, class A>
+  bool is_node_based(boost::concurrent_node_map<K, V, H, P, A>*)
+  {
+    return true;
+  }
+
+  template <class K, class H, class P, class A>
+  bool is_node_based(boost::concurrent_node_set<K, H, P, A>*)
+  {
+    return true;
+  }
+#elif defined(BOOST_UNORDERED_FOA_TESTS)
+  template <class X> bool is_node_based(X*) { return false; }
+
+  template <class K, class V, class H, class P, class A>
+  bool is_node_based(boost::unordered_node_map<K, V, H, P, A>*)
+  {
+    return true;
+  }
+
+  template <class K, class H, class P, class A>
+  bool is_node_based(boost::unordered_node_set<K, H, P, A>*)
+  {
+    return true;
+  }
+#else
+  template <class X> bool is_node_based(X*) { return true; }
+#endif
+
+  template <class X> void check_memory_usage(X const& x)
+  {
+    auto mu = x.memory_usage();
+    BOOST_TEST_EQ(mu.total, live_bytes);
+    BOOST_TEST_EQ(mu.total, mu.group_metadata + mu.element_slots + mu.nodes +
+                              mu.locks + mu.buckets + mu.other);
+    BOOST_TEST_EQ(mu.other, 0u);
+  }
+
+  template <class X> void memory_usage_matches_allocations(X*)
+  {
+    using value_type = typename X::value_type;
+
+    live_bytes = 0;
+    {
+      X x;
+      BOOST_TEST_EQ(x.memory_usage().total, 0u);
+      check_memory_usage(x);
+
+      for (int i = 0; i < 1000; ++i) {
+        x.insert(make_value(static_cast<value_type*>(nullptr), i));
+      }
+      check_memory_usage(x);
+
+      auto mu = x.memory_usage();
+      BOOST_TEST_GT(mu.group_metadata, 0u);
+      if (is_node_based(static_cast<X*>(nullptr))) {
+        BOOST_TEST_GE(mu.nodes, x.size() * sizeof(value_type));
+      } else {
+        BOOST_TEST_EQ(mu.nodes, 0u);
+      }
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+      BOOST_TEST_GT(mu.locks, 0u);
+#else
+      BOOST_TEST_EQ(mu.locks, 0u);
+#endif
+#if defined(BOOST_UNORDERED_FOA_TESTS) || defined(BOOST_UNORDERED_CFOA_TESTS)
+      BOOST_TEST_GT(mu.element_slots, 0u);
+      BOOST_TEST_EQ(mu.buckets, 0u);
+#else
+      BOOST_TEST_EQ(mu.element_slots, 0u);
+      BOOST_TEST_GT(mu.buckets, 0u);
+#endif
+
+      for (int i = 0; i < 1000; i += 2) {
+        x.erase(i);
+      }
+      check_memory_usage(x);
+
+      x.rehash(0);
+      check_memory_usage(x);
+
+      x.clear();
+      check_memory_usage(x);
+    }
+    BOOST_TEST_EQ(live_bytes, 0u);
+  }
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+  void epoch_reclamation_memory_usage()
+  {
+    using map_type = boost::concurrent_node_map<int, int, boost::hash<int>,
+      std::equal_to<int>, byte_counting_allocator<std::pair<int const, int> > >;
+
+    live_bytes = 0;
+    {
+      map_type x(boost::unordered::epoch_reclamation);
+      for (int i = 0; i < 1000; ++i) x.insert({i, i});
+      check_memory_usage(x);
+
+      // erased nodes are kept alive until no reader can be accessing them
+      for (int i = 0; i < 1000; i += 2) x.erase(i);
+      check_memory_usage(x);
+      BOOST_TEST_GE(
+        x.memory_usage().nodes, x.size() * sizeof(map_type::value_type));
+    }
+    BOOST_TEST_EQ(live_bytes, 0u);
+  }
+#endif
+} // namespace
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+static boost::concurrent_flat_map<int, int, boost::hash<int>,
+  std::equal_to<int>, byte_counting_allocator<std::pair<int const, int> > >*
+  test_map;
+static boost::concurrent_flat_set<int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<int> >* test_set;
+static boost::concurrent_node_map<int, int, boost::hash<int>,
+  std::equal_to<int>, byte_counting_allocator<std::pair<int const, int> > >*
+  test_node_map;
+static boost::concurrent_node_set<int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<int> >* test_node_set;
+
+// clang-format off
+UNORDERED_TEST(memory_usage_matches_allocations,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+
+UNORDERED_AUTO_TEST (epoch_reclamation_memory_usage_tests) {
+  epoch_reclamation_memory_usage();
+}
+// clang-format on
+#elif defined(BOOST_UNORDERED_FOA_TESTS)
+static boost::unordered_flat_map<int, int, boost::hash<int>,
+  std::equal_to<int>, byte_counting_allocator<std::pair<int const, int> > >*
+  test_map;
+static boost::unordered_flat_set<int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<int> >* test_set;
+static boost::unordered_node_map<int, int, boost::hash<int>,
+  std::equal_to<int>, byte_counting_allocator<std::pair<int const, int> > >*
+  test_node_map;
+static boost::unordered_node_set<int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<int> >* test_node_set;
+
+// clang-format off
+UNORDERED_TEST(memory_usage_matches_allocations,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+// clang-format on
+#else
+static boost::unordered_map<int, int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<std::pair<int const, int> > >* test_map;
+static boost::unordered_set<int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<int> >* test_set;
+static boost::unordered_multimap<int, int, boost::hash<int>,
+  std::equal_to<int>, byte_counting_allocator<std::pair<int const, int> > >*
+  test_multimap;
+static boost::unordered_multiset<int, boost::hash<int>, std::equal_to<int>,
+  byte_counting_allocator<int> >* test_multiset;
+
+// clang-format off
+UNORDERED_TEST(memory_usage_matches_allocations,
+  ((test_map)(test_set)(test_multimap)(test_multiset)))
+// clang-format on
+#endif
+
+RUN_TESTS()
@@ -0,0 +1,284 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/unordered/rehash_observer.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+struct test_rehash_observer
+{
+  static std::atomic<std::size_t> num_before, num_after, num_in_progress;
+  static boost::unordered::rehash_info last_before, last_after;
+
+  static void before_rehash(boost::unordered::rehash_info const& info) noexcept
+  {
+    ++num_before;
+    ++num_in_progress;
+    last_before = info;
+  }
+
+  static void after_rehash(boost::unordered::rehash_info const& info) noexcept
+  {
+    ++num_after;
+    --num_in_progress;
+    last_after = info;
+  }
+
+  static void reset()
+  {
+    num_before = 0;
+    num_after = 0;
+    num_in_progress = 0;
+  }
+};
+
+std::atomic<std::size_t> test_rehash_observer::num_before{0},
+  test_rehash_observer::num_after{0}, test_rehash_observer::num_in_progress{0};
+boost::unordered::rehash_info test_rehash_observer::last_before,
+  test_rehash_observer::last_after;
+
+#define BOOST_UNORDERED_REHASH_OBSERVER test_rehash_observer
+
+struct countdown_hash
+{
+  // throws when the countdown reaches zero
+  static std::atomic<int> countdown;
+
+  std::size_t operator()(int x) const
+  {
+    if (countdown.load() > 0 && --countdown == 0) {
+      throw std::runtime_error("countdown_hash");
+    }
+    return std::hash<int>()(x);
+  }
+};
+
+std::atomic<int> countdown_hash::countdown{0};
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include "../cfoa/helpers.hpp"
+#else
+#include "../helpers/unordered.hpp"
+#endif
+
+#include "../helpers/test.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace {
+  using observer = test_rehash_observer;
+
+  template <class T> T make_value(T*, int i) { return T(i); }
+
+  template <class K, class V>
+  std::pair<K, V> make_value(std::pair<K, V>*, int i)
+  {
+    return {i, i};
+  }
+
+  template <class X> void insert_n(X& x, int first, int last)
+  {
+    using value_type = typename X::value_type;
+    for (int i = first; i < last; ++i) {
+      x.insert(make_value(static_cast<value_type*>(nullptr), i));
+    }
+  }
+
+  template <class X> void rehash_notifications(X*)
+  {
+    observer::reset();
+
+    X x;
+    BOOST_TEST_EQ(observer::num_before, 0u);
+
+    // growth
+    std::size_t num_rehashes = 0;
+    for (int i = 0; i < 1000; ++i) {
+      auto bucket_count = x.bucket_count();
+      auto size = x.size();
+      insert_n(x, i, i + 1);
+      if (x.bucket_count() != bucket_count) {
+        ++num_rehashes;
+        BOOST_TEST_EQ(observer::num_before, num_rehashes);
+        BOOST_TEST_EQ(observer::num_after, num_rehashes);
+
+        auto const& b = observer::last_before;
+        auto const& a = observer::last_after;
+        BOOST_TEST_EQ(b.container, static_cast<void const*>(&x));
+        BOOST_TEST_EQ(b.old_bucket_count, bucket_count);
+        BOOST_TEST_EQ(b.new_bucket_count, x.bucket_count());
+        BOOST_TEST_EQ(b.size, size);
+        BOOST_TEST_GT(b.bytes_allocated, 0u);
+        BOOST_TEST_EQ(b.elapsed.count(), 0);
+
+        BOOST_TEST_EQ(a.container, b.container);
+        BOOST_TEST_EQ(a.old_bucket_count, b.old_bucket_count);
+        BOOST_TEST_EQ(a.new_bucket_count, b.new_bucket_count);
+        BOOST_TEST_EQ(a.size, b.size);
+        BOOST_TEST_EQ(a.bytes_allocated, b.bytes_allocated);
+        BOOST_TEST_GE(a.elapsed.count(), 0);
+        BOOST_TEST_EQ(b.num_lost, 0u);
+        BOOST_TEST_EQ(a.num_lost, 0u);
+      }
+    }
+    BOOST_TEST_GT(num_rehashes, 0u);
+    BOOST_TEST_EQ(observer::num_before, num_rehashes);
+
+    // explicit rehash
+    auto bytes_allocated = observer::last_after.bytes_allocated;
+    x.rehash(x.bucket_count() * 4);
+    BOOST_TEST_EQ(observer::num_after, num_rehashes + 1);
+    BOOST_TEST_EQ(observer::last_after.new_bucket_count, x.bucket_count());
+    BOOST_TEST_EQ(observer::last_after.size, x.size());
+    BOOST_TEST_GT(observer::last_after.bytes_allocated, bytes_allocated);
+
+    // no rehash, no notification
+    x.rehash(x.bucket_count());
+    BOOST_TEST_EQ(observer::num_before, num_rehashes + 1);
+    BOOST_TEST_EQ(observer::num_in_progress, 0u);
+  }
+
+  template <class X> void failed_rehash_notifications(X*)
+  {
+    observer::reset();
+
+    X x;
+    insert_n(x, 0, 4096);
+    auto const bucket_count = x.bucket_count();
+    auto const size = x.size();
+    auto const num_rehashes = observer::num_before.load();
+    BOOST_TEST_EQ(observer::num_after, num_rehashes);
+
+    // the container keeps its bucket array, so after_rehash is not issued
+    countdown_hash::countdown = 1000;
+    BOOST_TEST_THROWS(x.rehash(bucket_count * 4), std::runtime_error);
+    countdown_hash::countdown = 0;
+
+    BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+    BOOST_TEST_EQ(observer::num_before, num_rehashes + 1);
+    BOOST_TEST_EQ(observer::num_after, num_rehashes);
+    BOOST_TEST_EQ(observer::last_before.size, size);
+  }
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+  template <class X> void lossy_rehash_notifications(X*)
+  {
+    observer::reset();
+
+    X x;
+    insert_n(x, 0, 4096);
+    int i = static_cast<int>(x.size());
+    auto const bucket_count = x.bucket_count();
+    while (x.size() < x.max_load()) insert_n(x, i, i + 1), ++i;
+    BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+    auto const size = x.size();
+    auto const num_rehashes = observer::num_before.load();
+
+    // cooperative rehashing completes even if one element transfer throws
+    countdown_hash::countdown = 1000;
+    BOOST_TEST_THROWS(insert_n(x, -1, 0), std::runtime_error);
+    countdown_hash::countdown = 0;
+
+    BOOST_TEST_GT(x.bucket_count(), bucket_count);
+    BOOST_TEST_EQ(x.size() + 1, size);
+    BOOST_TEST_EQ(observer::num_before, num_rehashes + 1);
+    BOOST_TEST_EQ(observer::num_after, num_rehashes + 1);
+    BOOST_TEST_EQ(observer::num_in_progress, 0u);
+
+    auto const& a = observer::last_after;
+    BOOST_TEST_EQ(a.old_bucket_count, bucket_count);
+    BOOST_TEST_EQ(a.new_bucket_count, x.bucket_count());
+    BOOST_TEST_EQ(a.size, size);
+    BOOST_TEST_EQ(a.num_lost, 1u);
+    BOOST_TEST_EQ(observer::last_before.num_lost, 0u);
+  }
+
+  template <class X> void concurrent_rehash_notifications(X*)
+  {
+    observer::reset();
+
+    std::vector<int> keys(1024 * 64);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      keys[i] = static_cast<int>(i);
+    }
+
+    X x;
+    thread_runner(keys, [&x](boost::span<int> s) {
+      for (auto k : s) insert_n(x, k, k + 1);
+    });
+
+    BOOST_TEST_EQ(x.size(), keys.size());
+    BOOST_TEST_GT(observer::num_before, 0u);
+    BOOST_TEST_EQ(observer::num_after, observer::num_before.load());
+    BOOST_TEST_EQ(observer::num_in_progress, 0u);
+    BOOST_TEST_EQ(observer::last_after.new_bucket_count, x.bucket_count());
+  }
+#endif
+} // namespace
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+static boost::concurrent_flat_map<int, int>* test_map;
+static boost::concurrent_flat_set<int>* test_set;
+static boost::concurrent_node_map<int, int>* test_node_map;
+static boost::concurrent_node_set<int>* test_node_set;
+static boost::concurrent_flat_map<int, int, countdown_hash>* test_throwing_map;
+static boost::concurrent_node_map<int, int, countdown_hash>*
+  test_throwing_node_map;
+
+// clang-format off
+UNORDERED_TEST(rehash_notifications,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+
+UNORDERED_TEST(failed_rehash_notifications,
+  ((test_throwing_map)(test_throwing_node_map)))
+
+UNORDERED_TEST(lossy_rehash_notifications,
+  ((test_throwing_map)(test_throwing_node_map)))
+
+UNORDERED_TEST(concurrent_rehash_notifications,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+// clang-format on
+#elif defined(BOOST_UNORDERED_FOA_TESTS)
+static boost::unordered_flat_map<int, int>* test_map;
+static boost::unordered_flat_set<int>* test_set;
+static boost::unordered_node_map<int, int>* test_node_map;
+static boost::unordered_node_set<int>* test_node_set;
+static boost::unordered_flat_map<int, int, countdown_hash>* test_throwing_map;
+static boost::unordered_node_map<int, int, countdown_hash>*
+  test_throwing_node_map;
+
+// clang-format off
+UNORDERED_TEST(rehash_notifications,
+  ((test_map)(test_set)(test_node_map)(test_node_set)))
+
+UNORDERED_TEST(failed_rehash_notifications,
+  ((test_throwing_map)(test_throwing_node_map)))
+// clang-format on
+#else
+static boost::unordered_map<int, int>* test_map;
+static boost::unordered_set<int>* test_set;
+static boost::unordered_multimap<int, int>* test_multimap;
+static boost::unordered_multiset<int>* test_multiset;
+static boost::unordered_map<int, int, countdown_hash>* test_throwing_map;
+static boost::unordered_multimap<int, int, countdown_hash>*
+  test_throwing_multimap;
+
+// clang-format off
+UNORDERED_TEST(rehash_notifications,
+  ((test_map)(test_set)(test_multimap)(test_multiset)))
+
+UNORDERED_TEST(failed_rehash_notifications,
+  ((test_throwing_map)(test_throwing_multimap)))
+// clang-format on
+#endif
+
+RUN_TESTS()
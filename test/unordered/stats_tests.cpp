@@ -26,6 +26,12 @@
 #include <cmath>
 #include <cstring>
 
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+#include <atomic>
+#include <chrono>
+#include <thread>
+#endif
+
 template <class T> struct unequal_allocator
 {
   typedef T value_type;
@@ -106,11 +112,20 @@ template <class Stats> void check_stat(const Stats& s1, const Stats& s2)
   BOOST_TEST(esentially_same(s1.average, s2.average));
   BOOST_TEST(esentially_same(s1.variance, s2.variance));
   BOOST_TEST(esentially_same(s1.deviation, s2.deviation));
+  BOOST_TEST(s1.histogram.counts == s2.histogram.counts);
+}
+
+template <class Histogram> std::size_t histogram_count(const Histogram& h)
+{
+  std::size_t res = 0;
+  for (auto n : h.counts) res += n;
+  return res;
 }
 
 template <class Stats>
 void check_insertion_stats(const Stats& s, check_stats_contition cond)
 {
+  BOOST_TEST_EQ(histogram_count(s.probe_length.histogram), s.count);
   switch (cond) {
   case stats_empty:
     BOOST_TEST_EQ(s.count, 0);
@@ -135,6 +150,8 @@ void check_insertion_stats(const Stats& s1, const Stats& s2)
 template <class Stats>
 void check_lookup_stats(const Stats& s, check_stats_contition cond)
 {
+  BOOST_TEST_EQ(histogram_count(s.probe_length.histogram), s.count);
+  BOOST_TEST_EQ(histogram_count(s.num_comparisons.histogram), s.count);
   check_stat(s.probe_length, cond == stats_empty? stats_empty : stats_full);
   check_stat(s.num_comparisons, cond);
 }
@@ -160,8 +177,8 @@ void check_container_stats(const Stats& s, check_stats_contition cond)
     cond == stats_empty? stats_empty : stats_mostly_full);
 }
 
-template <class Stats>
-void check_container_stats(const Stats& s1, const Stats& s2)
+template <class Stats1, class Stats2>
+void check_container_stats(const Stats1& s1, const Stats2& s2)
 {
   check_insertion_stats(s1.insertion, s2.insertion);
   check_lookup_stats(s1.successful_lookup, s2.successful_lookup);
@@ -208,6 +225,29 @@ template <class Container> void test_stats()
   check_lookup_stats(
     s.unsuccessful_lookup, stats_mostly_full); // from insertion
 
+  // Histograms
+  auto const& h = s.insertion.probe_length.histogram;
+  BOOST_TEST_EQ(h.percentile(0.0), 1u); // probe length is at least 1
+  BOOST_TEST_EQ(h.percentile(0.5), 1u); // good hash function
+  BOOST_TEST_LE(h.percentile(0.5), h.percentile(0.99));
+  BOOST_TEST_LE(h.percentile(0.99), h.percentile(1.0));
+  BOOST_TEST_EQ(h.lower_bound(h.bucket_for(h.percentile(1.0))),
+    h.percentile(1.0));
+  BOOST_TEST_EQ(h.bucket_for(15), 15u);
+  BOOST_TEST_EQ(h.bucket_for(16), 16u);
+  BOOST_TEST_EQ(h.bucket_for(31), 16u);
+  BOOST_TEST_EQ(h.bucket_for(32), 17u);
+  BOOST_TEST_EQ(h.lower_bound(17), 32u);
+  BOOST_TEST_EQ(h.bucket_for(std::size_t(-1)), h.counts.size() - 1);
+
+  std::size_t num_groups = 0, num_elements = 0;
+  for (std::size_t i = 0; i < s.group_occupancy.counts.size(); ++i) {
+    num_groups += s.group_occupancy.counts[i];
+    num_elements += i * s.group_occupancy.counts[i];
+  }
+  BOOST_TEST_EQ(num_groups * 15, c.bucket_count() + 1);
+  BOOST_TEST_EQ(num_elements, c.size());
+
 #if !defined(BOOST_UNORDERED_CFOA_TESTS)
   // Inequality due to rehashing
   // May not hold in concurrent containers because of insertion retries
@@ -330,7 +370,218 @@ template <class Container> void test_stats()
   check_lookup_stats(c7.get_stats().unsuccessful_lookup, stats_empty);
 }
 
+#if defined(BOOST_UNORDERED_FOA_TESTS) || defined(BOOST_UNORDERED_CFOA_TESTS)
+template <class Container> void test_sampled_stats()
+{
+  BOOST_TEST_EQ(boost::unordered::stats_sampling_period(), 1u);
+  Container c0;
+  insert_n(c0, 10000);
+  auto n = c0.get_stats().insertion.count; // includes rehash insertions
+
+  boost::unordered::stats_sampling_period(16);
+  BOOST_TEST_EQ(boost::unordered::stats_sampling_period(), 16u);
+
+  // Counts are scaled by the sampling period
+  Container c;
+  insert_n(c, 10000);
+  auto s = c.get_stats();
+  BOOST_TEST_GT(s.insertion.count, n * 3 / 4);
+  BOOST_TEST_LT(s.insertion.count, n * 5 / 4);
+  BOOST_TEST_EQ(s.insertion.count % 16, 0u);
+  BOOST_TEST_GE(s.insertion.probe_length.average, 1.0);
+
+  std::size_t total = 0;
+  for (auto n : s.insertion.probe_length.histogram.counts) total += n;
+  BOOST_TEST_EQ(total, s.insertion.count);
+
+  boost::unordered::stats_sampling_period(0); // same as 1
+  BOOST_TEST_EQ(boost::unordered::stats_sampling_period(), 1u);
+  c.reset_stats();
+  insert_n(c, 10000);
+  BOOST_TEST_EQ(c.get_stats().successful_lookup.count, 10000u);
+}
+#endif
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS) && !defined(BOOST_UNORDERED_CFOA_TESTS)
+template <class Stats>
+void check_fca_lookup_stats(const Stats& s, check_stats_contition cond)
+{
+  BOOST_TEST_EQ(histogram_count(s.num_comparisons.histogram), s.count);
+  check_stat(s.num_comparisons, cond);
+}
+
+template <class Stats>
+void check_fca_lookup_stats(const Stats& s1, const Stats& s2)
+{
+  BOOST_TEST_EQ(s1.count, s2.count);
+  check_stat(s1.num_comparisons, s2.num_comparisons);
+}
+
+template <class Stats>
+void check_fca_container_stats(const Stats& s, check_stats_contition cond)
+{
+  check_fca_lookup_stats(s.successful_lookup, cond);
+  check_fca_lookup_stats(
+    s.unsuccessful_lookup,
+    cond == stats_empty? stats_empty : stats_mostly_full);
+  if (cond == stats_empty) {
+    BOOST_TEST_EQ(s.rehash.count, 0u);
+    BOOST_TEST_EQ(s.rehash.time.count(), 0);
+  }
+}
+
+template <class Stats>
+void check_fca_container_stats(const Stats& s1, const Stats& s2)
+{
+  check_fca_lookup_stats(s1.successful_lookup, s2.successful_lookup);
+  check_fca_lookup_stats(s1.unsuccessful_lookup, s2.unsuccessful_lookup);
+  BOOST_TEST_EQ(s1.rehash.count, s2.rehash.count);
+  BOOST_TEST(s1.rehash.time == s2.rehash.time);
+}
+
+template <class Container> void test_fca_stats()
+{
+  using stats = typename Container::stats;
+
+  Container        c;
+  const Container& cc = c;
+
+  // Stats initially empty
+  stats s = cc.get_stats();
+  check_fca_container_stats(s, stats_empty);
+  BOOST_TEST_EQ(histogram_count(s.bucket_size), c.bucket_count());
+
+  // Stats after insertion
+  insert_n(c, 10000);
+  s = cc.get_stats();
+  check_fca_lookup_stats(s.unsuccessful_lookup, stats_mostly_full);
+  BOOST_TEST_GE(s.unsuccessful_lookup.count, 10000u);
+  BOOST_TEST_GT(s.rehash.count, 0u);
+  BOOST_TEST_GT(s.rehash.time.count(), 0);
+
+  // Chain lengths
+  std::size_t num_buckets = 0, num_elements = 0;
+  for (std::size_t i = 0; i < s.bucket_size.counts.size(); ++i) {
+    num_buckets += s.bucket_size.counts[i];
+    num_elements += i * s.bucket_size.counts[i];
+  }
+  BOOST_TEST_EQ(num_buckets, c.bucket_count());
+  BOOST_TEST_EQ(num_elements, c.size());
+  BOOST_TEST_LT(s.bucket_size.percentile(0.99), 8u);
+
+  // Lookup
+  c.reset_stats();
+  check_fca_container_stats(cc.get_stats(), stats_empty);
+
+  test::reset_sequence();
+  test::random_values<Container> v2(15000, test::sequential);
+  std::size_t                    found = 0, not_found = 0;
+  for (const auto& x: v2) {
+    if (cc.contains(test::get_key<Container>(x))) ++found;
+    else                                          ++not_found;
+  }
+  s = cc.get_stats();
+  check_fca_lookup_stats(s.successful_lookup, stats_full);
+  check_fca_lookup_stats(s.unsuccessful_lookup, stats_mostly_full);
+  BOOST_TEST_EQ(s.successful_lookup.count, found);
+  BOOST_TEST_EQ(s.unsuccessful_lookup.count, not_found);
+  BOOST_TEST_GE(s.successful_lookup.num_comparisons.average, 1.0);
+  BOOST_TEST_EQ(s.rehash.count, 0u);
+
+  // Explicit rehash
+  c.rehash(c.bucket_count() * 2);
+  BOOST_TEST_EQ(cc.get_stats().rehash.count, 1u);
+
+  // Stats transferred on move and swap, reset in source
+  s = cc.get_stats();
+  Container c2(std::move(c));
+  check_fca_container_stats(c.get_stats(), stats_empty);
+  check_fca_container_stats(c2.get_stats(), s);
+
+  Container c3;
+  c3 = std::move(c2);
+  check_fca_container_stats(c2.get_stats(), stats_empty);
+  check_fca_container_stats(c3.get_stats(), s);
+
+  c3.swap(c2);
+  check_fca_container_stats(c3.get_stats(), stats_empty);
+  check_fca_container_stats(c2.get_stats(), s);
+}
+#endif
+
 #if defined(BOOST_UNORDERED_CFOA_TESTS)
+template <class Stats> void check_contention_stats_empty(const Stats& s)
+{
+  BOOST_TEST_EQ(s.num_shared_lock_spins, 0u);
+  BOOST_TEST_EQ(s.num_exclusive_lock_spins, 0u);
+  BOOST_TEST_EQ(s.num_writer_pending_events, 0u);
+  BOOST_TEST_EQ(s.num_insertion_restarts, 0u);
+  BOOST_TEST_EQ(s.num_rehash_stalls, 0u);
+  BOOST_TEST_EQ(s.rehash_stall_time.count(), 0);
+  BOOST_TEST_EQ(s.num_exclusive_locks, 0u);
+  BOOST_TEST_EQ(s.exclusive_lock_wait_time.count(), 0);
+}
+
+template <class Container, class F>
+void block_group_while(Container& c, bool exclusive, F f)
+{
+  using key_type = typename Container::key_type;
+  using value_type = typename Container::value_type;
+
+  // A thread holds the group lock of some element while f runs into it
+  key_type k{};
+  c.cvisit_all([&](value_type const& x) { k = test::get_key<Container>(x); });
+
+  std::atomic<bool> visiting{false};
+  auto hold = [&](value_type const&) {
+    visiting = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  };
+  std::thread th([&] {
+    if (exclusive) c.visit(k, hold);
+    else           c.cvisit(k, hold);
+  });
+  while (!visiting) std::this_thread::yield();
+  f(k);
+  th.join();
+}
+
+template <class Container> void test_contention_stats()
+{
+  using key_type = typename Container::key_type;
+
+  Container c;
+  check_contention_stats_empty(c.get_stats().contention);
+
+  // Growth rehashing stalls insertion and locks the container exclusively
+  insert_n(c, 10000);
+  auto s = c.get_stats().contention;
+  BOOST_TEST_GT(s.num_rehash_stalls, 0u);
+  BOOST_TEST_GT(s.rehash_stall_time.count(), 0);
+  BOOST_TEST_GT(s.num_exclusive_locks, 0u);
+  BOOST_TEST_GT(s.exclusive_lock_wait_time.count(), 0);
+
+  // Contended group locks
+  c.reset_stats();
+  check_contention_stats_empty(c.get_stats().contention);
+  block_group_while(c, true, [&](key_type const& k) { c.contains(k); });
+  s = c.get_stats().contention;
+  BOOST_TEST_GT(s.num_shared_lock_spins, 0u);
+  BOOST_TEST_EQ(s.num_exclusive_lock_spins, 0u);
+  BOOST_TEST_EQ(s.num_writer_pending_events, 0u);
+
+  // A writer waiting for a reader announces itself
+  block_group_while(c, false, [&](key_type const& k) { c.erase(k); });
+  s = c.get_stats().contention;
+  BOOST_TEST_GT(s.num_exclusive_lock_spins, 0u);
+  BOOST_TEST_GT(s.num_writer_pending_events, 0u);
+
+  // Contention stats are not transferred
+  Container c2(std::move(c));
+  check_contention_stats_empty(c2.get_stats().contention);
+  BOOST_TEST_GT(c.get_stats().contention.num_exclusive_locks, 0u);
+}
+
 template <class Container, class ConcurrentContainer>
 void test_stats_concurrent_unordered_interop()
 {
@@ -364,6 +615,11 @@ UNORDERED_AUTO_TEST (stats_) {
   test_stats<
     boost::concurrent_node_set<
       int, boost::hash<int>, std::equal_to<int>, unequal_allocator<int>>>();
+  test_sampled_stats<boost::concurrent_flat_map<int, int>>();
+  test_contention_stats<boost::concurrent_flat_map<int, int>>();
+  test_contention_stats<boost::concurrent_node_map<int, int>>();
+  test_contention_stats<boost::concurrent_flat_set<int>>();
+  test_contention_stats<boost::concurrent_node_set<int>>();
   test_stats_concurrent_unordered_interop<
     boost::unordered_flat_map<int, int>,
     boost::concurrent_flat_map<int, int>>();
@@ -391,8 +647,12 @@ UNORDERED_AUTO_TEST (stats_) {
   test_stats<
     boost::unordered_node_set<
       int, boost::hash<int>, std::equal_to<int>, unequal_allocator<int>>>();
+  test_sampled_stats<boost::unordered_flat_map<int, int>>();
 #else
-  // Closed-addressing containers do not provide stats
+  test_fca_stats<boost::unordered_map<int, int> >();
+  test_fca_stats<boost::unordered_multimap<int, int> >();
+  test_fca_stats<boost::unordered_set<int> >();
+  test_fca_stats<boost::unordered_multiset<int> >();
 #endif
 }
 
@@ -0,0 +1,348 @@
+// Copyright 2026 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Offline hash quality audit: inserts the keys read from a file into
+// boost::unordered_flat_set with the chosen hash function, with and without
+// post-mixing, and reports container statistics and timings so as to tell
+// whether the hash function can be safely marked as avalanching for the
+// data at hand.
+//
+// Usage: hash_quality [--binary] [--hash=boost|std|fnv1a] file
+//
+// Keys are read one per line, or as native-endian 64-bit unsigned integers
+// with --binary.
+
+#define BOOST_UNORDERED_ENABLE_STATS
+
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/config.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// hash functions
+
+template<int Bits> struct fnv1a_params;
+
+template<> struct fnv1a_params<32>
+{
+    static constexpr std::size_t offset_basis = 0x811C9DC5u;
+    static constexpr std::size_t prime = 0x01000193ul;
+};
+
+template<> struct fnv1a_params<64>
+{
+    static constexpr std::size_t offset_basis = 0xCBF29CE484222325ull;
+    static constexpr std::size_t prime = 0x00000100000001B3ull;
+};
+
+struct fnv1a_hash
+{
+    using params = fnv1a_params< std::numeric_limits<std::size_t>::digits >;
+
+    static std::size_t hash_bytes( unsigned char const* first, unsigned char const* last )
+    {
+        std::size_t h = params::offset_basis;
+
+        for( ; first != last; ++first )
+        {
+            h ^= *first;
+            h *= params::prime;
+        }
+
+        return h;
+    }
+
+    std::size_t operator()( std::string const& s ) const
+    {
+        auto p = reinterpret_cast<unsigned char const*>( s.data() );
+        return hash_bytes( p, p + s.size() );
+    }
+
+    std::size_t operator()( std::uint64_t x ) const
+    {
+        unsigned char b[ sizeof( x ) ];
+        std::memcpy( b, &x, sizeof( x ) );
+        return hash_bytes( b, b + sizeof( x ) );
+    }
+};
+
+// Wrappers hiding or forcing the avalanching trait of the underlying hash:
+// unordered_flat_set post-mixes the result of mixed_hash with mulx and uses
+// that of unmixed_hash as is.
+
+template<class Hash> struct mixed_hash
+{
+    Hash h;
+
+    template<class Key> std::size_t operator()( Key const& x ) const
+    {
+        return h( x );
+    }
+};
+
+template<class Hash> struct unmixed_hash
+{
+    using is_avalanching = std::true_type;
+
+    Hash h;
+
+    template<class Key> std::size_t operator()( Key const& x ) const
+    {
+        return h( x );
+    }
+};
+
+// key input
+
+static bool read_keys( char const* filename, std::vector<std::string>& keys )
+{
+    std::ifstream is( filename );
+    if( !is ) return false;
+
+    std::string line;
+
+    while( std::getline( is, line ) )
+    {
+        if( !line.empty() && line.back() == '\r' ) line.pop_back();
+        keys.push_back( line );
+    }
+
+    return true;
+}
+
+static bool read_keys( char const* filename, std::vector<std::uint64_t>& keys )
+{
+    std::ifstream is( filename, std::ios::binary );
+    if( !is ) return false;
+
+    std::uint64_t x;
+
+    while( is.read( reinterpret_cast<char*>( &x ), sizeof( x ) ) )
+    {
+        keys.push_back( x );
+    }
+
+    return true;
+}
+
+// keys most likely not present, for unsuccessful lookups
+
+static std::string absent_key( std::string const& x )
+{
+    return x + '\x7F';
+}
+
+static std::uint64_t absent_key( std::uint64_t x )
+{
+    return ~x;
+}
+
+// audit
+
+using stats = boost::unordered_flat_set<int>::stats;
+using layout_stats = boost::unordered_flat_set<int>::layout_stats_type;
+
+struct result
+{
+    std::size_t size;
+    std::size_t absent_keys_found;
+    double insertion_ns;
+    double successful_lookup_ns;
+    double unsuccessful_lookup_ns;
+    stats stats_;
+    layout_stats layout_;
+};
+
+template<class Duration> static double ns_per_op( Duration d, std::size_t n )
+{
+    return n? std::chrono::duration<double, std::nano>( d ).count() / static_cast<double>( n ): 0.0;
+}
+
+template<class Hash, class Key> BOOST_NOINLINE result audit( std::vector<Key> const& keys )
+{
+    boost::unordered_flat_set<Key, Hash> s;
+    std::size_t found = 0, absent_found = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for( auto const& x: keys ) s.insert( x );
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    for( auto const& x: keys ) found += s.contains( x );
+
+    auto t2 = std::chrono::steady_clock::now();
+
+    std::vector<Key> absent_keys;
+    absent_keys.reserve( keys.size() );
+
+    for( auto const& x: keys ) absent_keys.push_back( absent_key( x ) );
+
+    auto t3 = std::chrono::steady_clock::now();
+
+    for( auto const& x: absent_keys ) absent_found += s.contains( x );
+
+    auto t4 = std::chrono::steady_clock::now();
+
+    if( found != keys.size() )
+    {
+        std::cerr << "Inconsistent lookup results\n";
+    }
+
+    return {
+        s.size(),
+        absent_found,
+        ns_per_op( t1 - t0, keys.size() ),
+        ns_per_op( t2 - t1, keys.size() ),
+        ns_per_op( t4 - t3, absent_keys.size() ),
+        s.get_stats(),
+        s.layout_stats() };
+}
+
+static void print( char const* label, result const& r )
+{
+    auto const& st = r.stats_;
+    auto const& ls = r.layout_;
+
+    std::cout
+        << label << ":\n"
+        << "  insertion:           "
+            << std::setw( 8 ) << r.insertion_ns << " ns/op, probe length "
+            << st.insertion.probe_length.average << " (p99 "
+            << st.insertion.probe_length.histogram.percentile( 0.99 ) << ")\n"
+        << "  successful lookup:   "
+            << std::setw( 8 ) << r.successful_lookup_ns << " ns/op, probe length "
+            << st.successful_lookup.probe_length.average << " (p99 "
+            << st.successful_lookup.probe_length.histogram.percentile( 0.99 ) << ")"
+            << ", num comparisons " << st.successful_lookup.num_comparisons.average << "\n"
+        << "  unsuccessful lookup: "
+            << std::setw( 8 ) << r.unsuccessful_lookup_ns << " ns/op, probe length "
+            << st.unsuccessful_lookup.probe_length.average << " (p99 "
+            << st.unsuccessful_lookup.probe_length.histogram.percentile( 0.99 ) << ")"
+            << ", num comparisons " << st.unsuccessful_lookup.num_comparisons.average << "\n"
+        << "  layout:              "
+            << ls.num_groups << " groups, "
+            << ls.overflowed_group_ratio * 100 << "% overflowed, max probe length "
+            << ls.max_probe_length << ", reduced hash collisions "
+            << ls.num_reduced_hash_collisions << " ("
+            << ( r.size? 100.0 * static_cast<double>( ls.num_reduced_hash_collisions ) / static_cast<double>( r.size ): 0.0 )
+            << "%)\n\n";
+}
+
+// Dropping post-mixing is deemed safe if it does not noticeably degrade
+// probe lengths or the number of comparisons with respect to mulx mixing.
+
+static bool within( double x, double reference, double abs_tolerance )
+{
+    return x <= reference * 1.1 + abs_tolerance;
+}
+
+static bool avalanching_is_safe( result const& unmixed, result const& mixed, std::ostream& os )
+{
+    auto const& u = unmixed.stats_;
+    auto const& m = mixed.stats_;
+
+    bool res = true;
+
+    auto check = [ & ]( char const* what, double x, double reference, double abs_tolerance )
+    {
+        if( !within( x, reference, abs_tolerance ) )
+        {
+            os << "  " << what << ": " << x << " without mixing vs " << reference << " with mulx\n";
+            res = false;
+        }
+    };
+
+    check( "successful lookup probe length",
+        u.successful_lookup.probe_length.average, m.successful_lookup.probe_length.average, 0.05 );
+    check( "successful lookup comparisons",
+        u.successful_lookup.num_comparisons.average, m.successful_lookup.num_comparisons.average, 0.05 );
+    check( "unsuccessful lookup probe length",
+        u.unsuccessful_lookup.probe_length.average, m.unsuccessful_lookup.probe_length.average, 0.05 );
+    check( "unsuccessful lookup comparisons",
+        u.unsuccessful_lookup.num_comparisons.average, m.unsuccessful_lookup.num_comparisons.average, 0.05 );
+    check( "max probe length",
+        static_cast<double>( unmixed.layout_.max_probe_length ), static_cast<double>( mixed.layout_.max_probe_length ), 2.0 );
+
+    return res;
+}
+
+template<class Hash, class Key> static int run( char const* hash_name, std::vector<Key> const& keys )
+{
+    std::cout << keys.size() << " keys read, hash function: " << hash_name << "\n\n";
+
+    auto mixed = audit< mixed_hash<Hash> >( keys );
+    print( "with mulx post-mixing", mixed );
+
+    auto unmixed = audit< unmixed_hash<Hash> >( keys );
+    print( "without post-mixing (hash_is_avalanching)", unmixed );
+
+    std::cout << mixed.size << " distinct keys, " << mixed.absent_keys_found << " keys for unsuccessful lookup found\n";
+
+    if( avalanching_is_safe( unmixed, mixed, std::cout ) )
+    {
+        std::cout << "Marking " << hash_name << " as avalanching looks safe for this data.\n";
+        return 0;
+    }
+    else
+    {
+        std::cout << "Marking " << hash_name << " as avalanching is NOT safe for this data.\n";
+        return 1;
+    }
+}
+
+template<class Key> static int run( std::string const& hash_name, char const* filename )
+{
+    std::vector<Key> keys;
+
+    if( !read_keys( filename, keys ) )
+    {
+        std::cerr << "Cannot open " << filename << "\n";
+        return 2;
+    }
+
+    if( hash_name == "boost" ) return run< boost::hash<Key> >( "boost::hash", keys );
+    if( hash_name == "std" ) return run< std::hash<Key> >( "std::hash", keys );
+    if( hash_name == "fnv1a" ) return run< fnv1a_hash >( "FNV-1a", keys );
+
+    std::cerr << "Unknown hash function " << hash_name << "\n";
+    return 2;
+}
+
+int main( int argc, char** argv )
+{
+    bool binary = false;
+    std::string hash_name = "boost";
+    char const* filename = nullptr;
+
+    bool usage_error = false;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[ i ];
+
+        if( arg == "--binary" ) binary = true;
+        else if( arg.compare( 0, 7, "--hash=" ) == 0 ) hash_name = arg.substr( 7 );
+        else if( !filename && arg.compare( 0, 2, "--" ) != 0 ) filename = argv[ i ];
+        else usage_error = true;
+    }
+
+    if( !filename || usage_error )
+    {
+        std::cerr << "Usage: hash_quality [--binary] [--hash=boost|std|fnv1a] file\n";
+        return 2;
+    }
+
+    return binary? run<std::uint64_t>( hash_name, filename ): run<std::string>( hash_name, filename );
+}